@@ -15,7 +15,11 @@
 #define IMU_CS_PIN 6    // SPI CS IMU (sen_cs)
 
 // Barometer Configuration (BMP280)
-#define BARO_CS_PIN 3    // SPI CS BARO (bmp_cs)
+// #define BARO_CS_PIN 3    // SPI CS BARO (bmp_cs) - BMP280 runs on I2C, D3 is IMU_INT_PIN
+
+// External interrupts (the Nano only has these two)
+#define RTC_INT_PIN 2   // PCF8523 INT1, 1 Hz second tick (D2 = INT0)
+#define IMU_INT_PIN 3   // ICM-20948 INT1 data ready / wake-on-motion (D3 = INT1)
 
 // SPI Configuration
 #define SPI_MISO_PIN 12  // SPI MISO
@@ -27,7 +31,7 @@
 // ============================================================================
 
 // Pyrotechnic Control Pins
-#define BOOSTER_IGNITION_PIN 2
+#define BOOSTER_IGNITION_PIN 8    // Off D2: that's RTC_INT_PIN
 #define NOSE_FAIRING_PIN 4
 #define STAGE_SEPARATION_PIN 5
 #define PAYLOAD_DEPLOY_PIN 7
@@ -40,7 +44,21 @@
 
 // Status Indicators
 #define STATUS_LED_PIN 13
-#define BUZZER_PIN A0
+#define BUZZER_PIN 10   // Off A0: that's PARACHUTE_DEPLOY_PIN
+
+// Outputs must stay off the interrupt inputs and the pyro channels
+#define PIN_ON_INTERRUPT(p) ((p) == RTC_INT_PIN || (p) == IMU_INT_PIN)
+static_assert(!PIN_ON_INTERRUPT(BOOSTER_IGNITION_PIN) && !PIN_ON_INTERRUPT(NOSE_FAIRING_PIN) &&
+              !PIN_ON_INTERRUPT(STAGE_SEPARATION_PIN) && !PIN_ON_INTERRUPT(PAYLOAD_DEPLOY_PIN) &&
+              !PIN_ON_INTERRUPT(PARACHUTE_DEPLOY_PIN), "Pyro channel on an interrupt pin");
+static_assert(!PIN_ON_INTERRUPT(SD_CS_PIN) && !PIN_ON_INTERRUPT(IMU_CS_PIN) &&
+              !PIN_ON_INTERRUPT(PAYLOAD_POWER_PIN) && !PIN_ON_INTERRUPT(BUZZER_PIN),
+              "Output on an interrupt pin");
+#define PIN_ON_PYRO(p) ((p) == BOOSTER_IGNITION_PIN || (p) == NOSE_FAIRING_PIN || \
+                        (p) == STAGE_SEPARATION_PIN || (p) == PAYLOAD_DEPLOY_PIN || \
+                        (p) == PARACHUTE_DEPLOY_PIN)
+static_assert(!PIN_ON_PYRO(BUZZER_PIN) && !PIN_ON_PYRO(STATUS_LED_PIN) && !PIN_ON_PYRO(SD_CS_PIN) &&
+              !PIN_ON_PYRO(IMU_CS_PIN) && !PIN_ON_PYRO(PAYLOAD_POWER_PIN), "Output on a pyro channel");
 
 // ============================================================================
 // SEQUENCER TIMING CONSTANTS
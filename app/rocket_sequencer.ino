@@ -21,6 +21,8 @@
 #include "sequencer.h"
 #include "hardware_control.h"
 #include "flight_detection.h"
+#include "timed_output.h"
+#include "pad_idle.h"
 
 // Include existing sensor framework
 #include "baro.h"
@@ -54,6 +56,10 @@ void loop() {
   // Update GPS continuously (from existing code)
   updateGPS();
   
+  // Wake from pad idle on motion, end pyro pulses on time and drain the
+  // IMU FIFO into the launch detector (never blocks)
+  bool pulsing = serviceSequencerInputs();
+  
   // Check for emergency abort conditions
   checkEmergencyConditions();
   
@@ -64,8 +70,8 @@ void loop() {
   }
   
   // Collect telemetry at appropriate rate
-  unsigned long telemRate = (sequencer.currentPhase == PHASE_LAUNCH || 
-                            sequencer.currentPhase == PHASE_FLIGHT) ? 
+  unsigned long telemRate = (currentMissionPhase() == PHASE_LAUNCH || 
+                            currentMissionPhase() == PHASE_FLIGHT) ? 
                             FAST_TELEM_RATE_MS : NORMAL_TELEM_RATE_MS;
   
   static unsigned long lastTelemTime = 0;
@@ -81,7 +87,12 @@ void loop() {
   // Status indication
   blinkSequencerStatus();
   
-  delay(10); // Small delay for system stability
+  // Pad idle: sleep to the next baro tick or motion, never with a pulse running
+  if (isPadIdle() && !pulsing) {
+    padIdleSleep();
+  } else {
+    delay(10); // Small delay for system stability
+  }
 }
 
 // Enhanced sensor initialization with sequencer integration
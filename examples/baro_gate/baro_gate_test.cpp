@@ -0,0 +1,121 @@
+/*
+ * Barometer Innovation Gate Test
+ *
+ * Feeds simulated altitude profiles with injected pressure spikes through
+ * the gate in include/baro_gate.h and checks which samples it rejects.
+ *
+ * Test Scenarios:
+ * 1. Pad noise with a single ejection-sized spike (must be rejected)
+ * 2. Boost/coast flight at the forced-mode tick with a spike at burnout
+ *    and an ejection spike at apogee (spikes rejected, real flight tracked)
+ * 3. Genuine step change (followed after BARO_GATE_MAX_REJECTS samples)
+ *
+ * No hardware required. Runs as a sketch (./run_test.sh) or on the host:
+ *   g++ -Iinclude -Iexamples examples/baro_gate/baro_gate_test.cpp -o baro_gate_test
+ */
+
+#include "test_report.h"
+#include "baro_gate.h"
+
+#define SAMPLE_DT 0.5                   // 2 Hz pad logging
+#define FLIGHT_DT (BARO_TICK_MS / 1000.0) // Forced-mode tick
+
+void testPadSpike() {
+  BaroGate gate;
+  resetBaroGate(gate);
+  bool spikeRejected = false;
+  bool cleanRejected = false;
+
+  for (int i = 0; i < 60; i++) {
+    float alt = 150.0 + noiseF(0.3);
+    bool spike = (i == 30);
+    if (spike) alt += 40.0;
+    bool accepted = baroGateAccept(gate, alt, SAMPLE_DT);
+    if (spike) spikeRejected = !accepted;
+    else if (!accepted) cleanRejected = true;
+  }
+
+  report("pad: ejection spike rejected", spikeRejected);
+  report("pad: no clean samples rejected", !cleanRejected);
+  report("pad: rejected count is 1", gate.rejectedCount == 1);
+}
+
+void testFlightSpikes() {
+  BaroGate gate;
+  resetBaroGate(gate);
+  float alt = 0.0, vel = 0.0;
+  bool transonicRejected = false;
+  bool ejectionRejected = false;
+  int cleanRejects = 0;
+  float apogee = 0.0;
+
+  int samples = (int)(30.0 / FLIGHT_DT);
+  for (int i = 0; i < samples; i++) {
+    float t = i * FLIGHT_DT;
+    float accel = (t > 1.0 && t <= 3.0) ? 8.0 * 9.81 : -9.81;
+    if (t > 1.0) {
+      alt += (vel + 0.5 * accel * FLIGHT_DT) * FLIGHT_DT;
+      vel += accel * FLIGHT_DT;
+    }
+    if (alt < 0.0) alt = 0.0;
+    if (alt > apogee) apogee = alt;
+
+    float measured = alt + noiseF(0.3);
+    bool transonic = (i == (int)(3.0 / FLIGHT_DT));  // Burnout, max velocity
+    bool ejection = (vel < 0.0 && !ejectionRejected && gate.consecutiveRejects == 0 &&
+                     apogee - alt < 5.0);
+    if (transonic) measured -= 60.0;
+    if (ejection) measured += 50.0;
+
+    bool accepted = baroGateAccept(gate, measured, FLIGHT_DT);
+    if (transonic) transonicRejected = !accepted;
+    else if (ejection) ejectionRejected = !accepted;
+    else if (!accepted) cleanRejects++;
+  }
+
+  report("flight: transonic spike rejected", transonicRejected);
+  report("flight: ejection spike rejected", ejectionRejected);
+  report("flight: no clean samples rejected", cleanRejects == 0);
+}
+
+void testRealStep() {
+  BaroGate gate;
+  resetBaroGate(gate);
+  int rejected = 0;
+
+  for (int i = 0; i < 40; i++) {
+    float alt = (i < 20 ? 100.0 : 160.0) + noiseF(0.3);
+    if (!baroGateAccept(gate, alt, SAMPLE_DT)) rejected++;
+  }
+
+  report("step: followed after max rejects", rejected == BARO_GATE_MAX_REJECTS);
+  report("step: tracker settled", gate.altitude > 155.0 && gate.altitude < 165.0);
+}
+
+void runTests() {
+  testPadSpike();
+  testFlightSpikes();
+  testRealStep();
+}
+
+#ifdef ARDUINO
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println(F("========================================"));
+  Serial.println(F("Baro Innovation Gate Test"));
+  Serial.println(F("========================================"));
+
+  runTests();
+  Serial.println(failures == 0 ? F("ALL TESTS PASSED") : F("TESTS FAILED"));
+}
+
+void loop() {}
+#else
+int main() {
+  runTests();
+  printf("%s\n", failures == 0 ? "ALL TESTS PASSED" : "TESTS FAILED");
+  return failures == 0 ? 0 : 1;
+}
+#endif
@@ -0,0 +1,196 @@
+/*
+ * ICM-20948 Bank Shadowing Test
+ *
+ * Drives the vendored library's C layer (util/ICM_20948_C.c) against a
+ * register-file stand-in with four banks and a REG_BANK_SEL register, and
+ * checks that the bank shadow and full-scale cache never read or write the
+ * wrong bank while cutting the transactions per getAGMT.
+ *
+ * Test Scenarios:
+ * 1. Full-scale writes land in bank 2
+ * 2. getAGMT returns bank 0 data with the cached full-scale settings
+ * 3. Steady-state getAGMT costs one 24-byte transaction
+ * 4. Accesses to other banks in between still read the right bank
+ * 5. A failed bank write is retried instead of trusted
+ * 6. A software reset drops the cache and re-reads the defaults
+ *
+ * No hardware required. Runs as a sketch (./run_test.sh) or on the host:
+ *   L=libraries/SparkFun_ICM-20948_ArduinoLibrary-main/src
+ *   gcc -c $L/util/ICM_20948_C.c -o /tmp/icm_c.o
+ *   g++ -I$L -Iexamples examples/icm_bank_shadow/icm_bank_shadow_test.cpp /tmp/icm_c.o -o icm_bank_shadow_test
+ */
+
+#include "test_report.h"
+#ifdef ARDUINO
+#include "ICM_20948.h"
+#else
+#include <string.h>
+#include "util/ICM_20948_C.h"
+#endif
+
+// Register-file stand-in: 4 banks x 128 registers, REG_BANK_SEL in every bank
+struct RegisterFile {
+  uint8_t regs[4][128];
+  uint8_t bank;
+  uint16_t bankWrites;
+  bool failNextBankWrite;
+};
+
+RegisterFile chip;
+
+void resetChip() {
+  memset(chip.regs, 0, sizeof(chip.regs));
+  chip.bank = 0;
+}
+
+ICM_20948_Status_e fakeWrite(uint8_t reg, uint8_t *data, uint32_t len, void *user) {
+  (void)user;
+  if (reg == REG_BANK_SEL) {
+    chip.bankWrites++;
+    if (chip.failNextBankWrite) {
+      chip.failNextBankWrite = false;
+      chip.bank = 1;  // Bus glitch: the chip ends up somewhere else
+      return ICM_20948_Stat_Err;
+    }
+    chip.bank = (data[0] >> 4) & 0x03;
+    return ICM_20948_Stat_Ok;
+  }
+  if (chip.bank == 0 && reg == AGB0_REG_PWR_MGMT_1 && (data[0] & 0x80)) {
+    resetChip();  // DEVICE_RESET
+    return ICM_20948_Stat_Ok;
+  }
+  for (uint32_t i = 0; i < len; i++) chip.regs[chip.bank][(reg + i) & 0x7F] = data[i];
+  return ICM_20948_Stat_Ok;
+}
+
+ICM_20948_Status_e fakeRead(uint8_t reg, uint8_t *data, uint32_t len, void *user) {
+  (void)user;
+  for (uint32_t i = 0; i < len; i++) data[i] = chip.regs[chip.bank][(reg + i) & 0x7F];
+  return ICM_20948_Stat_Ok;
+}
+
+const ICM_20948_Serif_t fakeSerif = {fakeWrite, fakeRead, NULL};
+ICM_20948_Device_t dev;
+
+void setup16g2000dps() {
+  ICM_20948_fss_t fss;
+  fss.a = gpm16;
+  fss.g = dps2000;
+  ICM_20948_set_full_scale(&dev, (ICM_20948_InternalSensorID_bm)(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr), fss);
+}
+
+void testFullScaleBank() {
+  resetChip();
+  chip.bank = 3;  // Power-on bank unknown to the driver
+  ICM_20948_init_struct(&dev);
+  ICM_20948_link_serif(&dev, &fakeSerif);
+  setup16g2000dps();
+
+  report("fss: accel FS_SEL in bank 2", ((chip.regs[2][AGB2_REG_ACCEL_CONFIG] >> 1) & 0x03) == gpm16);
+  report("fss: gyro FS_SEL in bank 2", ((chip.regs[2][AGB2_REG_GYRO_CONFIG_1] >> 1) & 0x03) == dps2000);
+  report("fss: nothing leaked into bank 3", chip.regs[3][AGB2_REG_ACCEL_CONFIG] == 0);
+}
+
+void testAgmtData() {
+  // Accel X = 0x1234, gyro Z = -2 in bank 0; decoy values in bank 2
+  chip.regs[0][AGB0_REG_ACCEL_XOUT_H] = 0x12;
+  chip.regs[0][AGB0_REG_ACCEL_XOUT_H + 1] = 0x34;
+  chip.regs[0][AGB0_REG_ACCEL_XOUT_H + 10] = 0xFF;
+  chip.regs[0][AGB0_REG_ACCEL_XOUT_H + 11] = 0xFE;
+  chip.regs[2][AGB0_REG_ACCEL_XOUT_H] = 0x55;
+
+  ICM_20948_AGMT_t agmt;
+  ICM_20948_Status_e stat = ICM_20948_get_agmt(&dev, &agmt);
+  report("agmt: status ok", stat == ICM_20948_Stat_Ok);
+  report("agmt: accel X from bank 0", agmt.acc.axes.x == 0x1234);
+  report("agmt: gyro Z from bank 0", agmt.gyr.axes.z == -2);
+  report("agmt: cached full scale", agmt.fss.a == gpm16 && agmt.fss.g == dps2000);
+}
+
+void testSteadyStateCost() {
+  ICM_20948_AGMT_t agmt;
+  ICM_20948_get_agmt(&dev, &agmt);  // Settle in bank 0
+  dev._txn_count = 0;
+  dev._txn_bytes = 0;
+  chip.bankWrites = 0;
+
+  for (int i = 0; i < 10; i++) ICM_20948_get_agmt(&dev, &agmt);
+
+#ifndef ARDUINO
+  printf("     getAGMT: %lu transactions, %lu bytes per call\n",
+         (unsigned long)dev._txn_count / 10, (unsigned long)dev._txn_bytes / 10);
+#endif
+  report("cost: one transaction per getAGMT", dev._txn_count == 10);
+  report("cost: 24 bytes per getAGMT", dev._txn_bytes == 10 * 24);
+  report("cost: no bank writes", chip.bankWrites == 0);
+}
+
+void testInterleavedBanks() {
+  // Touch bank 2 and bank 3 registers, then read data again
+  ICM_20948_dlpcfg_t dlpf;
+  dlpf.a = acc_d50bw4_n68bw8;
+  dlpf.g = gyr_d51bw2_n73bw3;
+  ICM_20948_set_dlpf_cfg(&dev, (ICM_20948_InternalSensorID_bm)(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr), dlpf);
+  ICM_20948_set_bank(&dev, 3);
+
+  ICM_20948_AGMT_t agmt;
+  ICM_20948_get_agmt(&dev, &agmt);
+  report("interleave: accel X still from bank 0", agmt.acc.axes.x == 0x1234);
+  report("interleave: DLPF kept FS_SEL", ((chip.regs[2][AGB2_REG_ACCEL_CONFIG] >> 1) & 0x03) == gpm16);
+  report("interleave: full scale still cached", agmt.fss.a == gpm16 && agmt.fss.g == dps2000);
+}
+
+void testFailedBankWrite() {
+  ICM_20948_set_bank(&dev, 0);
+  chip.failNextBankWrite = true;
+  ICM_20948_Status_e stat = ICM_20948_set_bank(&dev, 2);
+  report("fail: error returned", stat != ICM_20948_Stat_Ok);
+
+  // Chip is now in bank 1; asking for bank 2 again must not be skipped
+  ICM_20948_set_bank(&dev, 2);
+  report("fail: bank write retried", chip.bank == 2);
+}
+
+void testSoftwareReset() {
+  ICM_20948_sw_reset(&dev);
+  ICM_20948_AGMT_t agmt;
+  ICM_20948_get_agmt(&dev, &agmt);
+  report("reset: full scale re-read as defaults", agmt.fss.a == gpm2 && agmt.fss.g == dps250);
+
+  // The reset cleared the data registers; new data must come from bank 0
+  chip.regs[0][AGB0_REG_ACCEL_XOUT_H + 1] = 0x07;
+  chip.regs[2][AGB0_REG_ACCEL_XOUT_H + 1] = 0x66;
+  ICM_20948_get_agmt(&dev, &agmt);
+  report("reset: data read from bank 0", agmt.acc.axes.x == 0x07);
+}
+
+void runTests() {
+  testFullScaleBank();
+  testAgmtData();
+  testSteadyStateCost();
+  testInterleavedBanks();
+  testFailedBankWrite();
+  testSoftwareReset();
+}
+
+#ifdef ARDUINO
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println(F("========================================"));
+  Serial.println(F("ICM-20948 Bank Shadowing Test"));
+  Serial.println(F("========================================"));
+
+  runTests();
+  Serial.println(failures == 0 ? F("ALL TESTS PASSED") : F("TESTS FAILED"));
+}
+
+void loop() {}
+#else
+int main() {
+  runTests();
+  printf("%s\n", failures == 0 ? "ALL TESTS PASSED" : "TESTS FAILED");
+  return failures == 0 ? 0 : 1;
+}
+#endif
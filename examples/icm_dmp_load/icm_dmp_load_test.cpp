@@ -0,0 +1,160 @@
+/*
+ * ICM-20948 DMP Firmware Load Test
+ *
+ * Loads the 14301-byte DMP image through the vendored library's C layer
+ * (util/ICM_20948_C.c) into a stand-in for the chip's DMP memory, which is
+ * reached through MEM_BANK_SEL / MEM_START_ADDR / MEM_R_W. The stand-in
+ * flags bursts that cross a 256-byte memory bank or that don't start with
+ * a fresh MEM_START_ADDR write.
+ *
+ * Test Scenarios:
+ * 1. Image lands intact at DMP_LOAD_START, nothing written outside it
+ * 2. Every burst stays inside one memory bank and has its own start address
+ * 3. Load plus verify fits in a few hundred transactions
+ * 4. A stuck bit in DMP memory fails the verify
+ * 5. A second load is a no-op
+ *
+ * Host only (the DMP memory stand-in needs 64 KB of RAM):
+ *   L=libraries/SparkFun_ICM-20948_ArduinoLibrary-main/src
+ *   gcc -DICM_20948_USE_DMP -c $L/util/ICM_20948_C.c -o /tmp/icm_dmp.o
+ *   g++ -DICM_20948_USE_DMP -I$L -Iexamples examples/icm_dmp_load/icm_dmp_load_test.cpp /tmp/icm_dmp.o -o icm_dmp_load_test
+ */
+
+#include <string.h>
+#include "test_report.h"
+#include "util/ICM_20948_C.h"
+
+#define DMP_IMAGE_SIZE 14301
+#define SPI_US_PER_BYTE 1.14   // 8 bits at IMU_SPI_FREQ (7 MHz)
+#define SPI_US_PER_TXN 6.0     // CS toggle, address byte setup, call overhead on the Nano
+
+extern "C" const uint8_t dmp3_image[];
+
+// Bank 0 registers plus 64 KB of DMP memory behind the MEM_* window
+struct DmpChip {
+  uint8_t regs[128];
+  uint8_t mem[65536];
+  bool written[65536];
+  uint8_t memBank;
+  uint8_t startAddr;
+  bool startFresh;       // MEM_START_ADDR written since the last MEM_R_W burst
+  uint16_t stuckAddr;    // Reads back with bit 0 clear (0 = none)
+  uint16_t bankCrossings;
+  uint16_t staleStarts;
+};
+
+DmpChip chip;
+
+void resetChip() {
+  memset(&chip, 0, sizeof(chip));
+}
+
+// One MEM_R_W burst: checks the bank and start-address rules the real part relies on
+uint16_t burstAddress(uint32_t len) {
+  if (!chip.startFresh) chip.staleStarts++;
+  chip.startFresh = false;
+  if (chip.startAddr + len > 0x100) chip.bankCrossings++;
+  return ((uint16_t)chip.memBank << 8) | chip.startAddr;
+}
+
+ICM_20948_Status_e fakeWrite(uint8_t reg, uint8_t *data, uint32_t len, void *user) {
+  (void)user;
+  if (reg == AGB0_REG_MEM_BANK_SEL) {
+    chip.memBank = data[0];
+  } else if (reg == AGB0_REG_MEM_START_ADDR) {
+    chip.startAddr = data[0];
+    chip.startFresh = true;
+  } else if (reg == AGB0_REG_MEM_R_W) {
+    uint16_t addr = burstAddress(len);
+    for (uint32_t i = 0; i < len; i++) {
+      chip.mem[(uint16_t)(addr + i)] = data[i];
+      chip.written[(uint16_t)(addr + i)] = true;
+    }
+  } else {
+    for (uint32_t i = 0; i < len; i++) chip.regs[(reg + i) & 0x7F] = data[i];
+  }
+  return ICM_20948_Stat_Ok;
+}
+
+ICM_20948_Status_e fakeRead(uint8_t reg, uint8_t *data, uint32_t len, void *user) {
+  (void)user;
+  if (reg == AGB0_REG_MEM_R_W) {
+    uint16_t addr = burstAddress(len);
+    for (uint32_t i = 0; i < len; i++) {
+      uint16_t a = addr + i;
+      data[i] = chip.mem[a];
+      if (chip.stuckAddr && a == chip.stuckAddr) data[i] &= 0xFE;
+    }
+  } else {
+    for (uint32_t i = 0; i < len; i++) data[i] = chip.regs[(reg + i) & 0x7F];
+  }
+  return ICM_20948_Stat_Ok;
+}
+
+const ICM_20948_Serif_t fakeSerif = {fakeWrite, fakeRead, NULL};
+ICM_20948_Device_t dev;
+
+ICM_20948_Status_e loadFresh() {
+  ICM_20948_init_struct(&dev);
+  ICM_20948_link_serif(&dev, &fakeSerif);
+  dev._dmp_firmware_available = true;
+  return ICM_20948_firmware_load(&dev);
+}
+
+void testImageIntact() {
+  resetChip();
+  ICM_20948_Status_e stat = loadFresh();
+  report("image: load ok", stat == ICM_20948_Stat_Ok && dev._firmware_loaded);
+  report("image: contents match", memcmp(&chip.mem[DMP_LOAD_START], dmp3_image, DMP_IMAGE_SIZE) == 0);
+
+  bool outside = false;
+  for (uint32_t a = 0; a < 65536; a++) {
+    bool inside = a >= DMP_LOAD_START && a < DMP_LOAD_START + DMP_IMAGE_SIZE;
+    if (chip.written[a] != inside) outside = true;
+  }
+  report("image: nothing written outside the image", !outside);
+}
+
+void testBurstRules() {
+  report("bursts: none cross a memory bank", chip.bankCrossings == 0);
+  report("bursts: each has its own start address", chip.staleStarts == 0);
+}
+
+void testCost() {
+  printf("     load + verify: %lu transactions, %lu bytes, ~%.0f ms bus time at 7 MHz\n",
+         (unsigned long)dev._txn_count, (unsigned long)dev._txn_bytes,
+         (dev._txn_count * SPI_US_PER_TXN + dev._txn_bytes * SPI_US_PER_BYTE) / 1000.0);
+  report("cost: under 600 transactions", dev._txn_count < 600);
+  report("cost: under 1 KB of overhead for load + verify", dev._txn_bytes < 2UL * DMP_IMAGE_SIZE + 1024);
+}
+
+void testStuckBit() {
+  resetChip();
+  chip.stuckAddr = DMP_LOAD_START + 0x1234;
+  while (!(dmp3_image[chip.stuckAddr - DMP_LOAD_START] & 1)) chip.stuckAddr++;
+  ICM_20948_Status_e stat = loadFresh();
+  report("verify: stuck bit detected", stat == ICM_20948_Stat_DMPVerifyFail);
+  report("verify: firmware not marked loaded", !dev._firmware_loaded);
+}
+
+void testReload() {
+  resetChip();
+  loadFresh();
+  dev._txn_count = 0;
+  ICM_20948_Status_e stat = ICM_20948_firmware_load(&dev);
+  report("reload: no-op once loaded", stat == ICM_20948_Stat_Ok && dev._txn_count == 0);
+}
+
+void runTests() {
+  testImageIntact();
+  testBurstRules();
+  testCost();
+  testStuckBit();
+  testReload();
+}
+
+int main() {
+  runTests();
+  printf("%s\n", failures == 0 ? "ALL TESTS PASSED" : "TESTS FAILED");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+/*
+ * IMU Bias Calibration Record Test
+ *
+ * Exercises include/imu_bias.h: bias computation from pad samples, the
+ * EEPROM record CRC, and the offset register encodings.
+ *
+ * Test Scenarios:
+ * 1. Level, still pad: biases recovered from simulated samples
+ * 2. Tilted or moving board: calibration refused
+ * 3. Blank, corrupted and valid EEPROM records
+ * 4. Register encodings (factory trim kept, reserved bit kept, clamping)
+ *
+ * No hardware required. Runs as a sketch (./run_test.sh) or on the host:
+ *   g++ -Iinclude -Iexamples examples/imu_bias/imu_bias_test.cpp -o imu_bias_test
+ */
+
+#include <string.h>
+#include "test_report.h"
+#include "imu_bias.h"
+
+// Sum IMU_BIAS_SAMPLES samples of a board reading accel/gyro (counts) plus noise
+void simulatePad(const int16_t accel[3], const int16_t gyro[3], int32_t accelSum[3], int32_t gyroSum[3]) {
+  for (uint8_t axis = 0; axis < 3; axis++) accelSum[axis] = gyroSum[axis] = 0;
+  for (uint16_t i = 0; i < IMU_BIAS_SAMPLES; i++) {
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      accelSum[axis] += accel[axis] + noise(8);
+      gyroSum[axis] += gyro[axis] + noise(4);
+    }
+  }
+}
+
+bool near(int16_t a, int16_t b, int16_t tol) {
+  return a - b <= tol && b - a <= tol;
+}
+
+void testLevelPad() {
+  const int16_t accel[3] = {40, -25, IMU_BIAS_ONE_G + 60};
+  const int16_t gyro[3] = {12, -30, 7};
+  int32_t accelSum[3], gyroSum[3];
+  simulatePad(accel, gyro, accelSum, gyroSum);
+
+  IMUBiasRecord rec;
+  bool ok = computeIMUBias(accelSum, gyroSum, IMU_BIAS_SAMPLES, rec);
+  report("level: calibration accepted", ok);
+  report("level: accel bias X/Y", near(rec.accel[0], 40, 1) && near(rec.accel[1], -25, 1));
+  report("level: accel bias Z excludes 1 g", near(rec.accel[2], 60, 1));
+  report("level: gyro bias", near(rec.gyro[0], 12, 1) && near(rec.gyro[1], -30, 1) && near(rec.gyro[2], 7, 1));
+  report("level: record valid", imuBiasValid(rec));
+}
+
+void testRejected() {
+  int32_t accelSum[3], gyroSum[3];
+  IMUBiasRecord rec;
+
+  const int16_t tilted[3] = {600, 0, 1950};  // ~17 degrees
+  const int16_t still[3] = {0, 0, 0};
+  simulatePad(tilted, still, accelSum, gyroSum);
+  report("reject: tilted board", !computeIMUBias(accelSum, gyroSum, IMU_BIAS_SAMPLES, rec));
+
+  const int16_t level[3] = {0, 0, IMU_BIAS_ONE_G};
+  const int16_t turning[3] = {0, 0, 500};    // 30 dps
+  simulatePad(level, turning, accelSum, gyroSum);
+  report("reject: rotating board", !computeIMUBias(accelSum, gyroSum, IMU_BIAS_SAMPLES, rec));
+
+  report("reject: no samples", !computeIMUBias(accelSum, gyroSum, 0, rec));
+}
+
+void testRecordCrc() {
+  IMUBiasRecord rec;
+  memset(&rec, 0xFF, sizeof(rec));
+  report("crc: blank EEPROM rejected", !imuBiasValid(rec));
+
+  int32_t accelSum[3] = {0, 0, (int32_t)IMU_BIAS_ONE_G * 4};
+  int32_t gyroSum[3] = {20, 0, -20};
+  computeIMUBias(accelSum, gyroSum, 4, rec);
+  report("crc: fresh record valid", imuBiasValid(rec));
+
+  IMUBiasRecord corrupt = rec;
+  corrupt.gyro[1] ^= 0x0100;
+  report("crc: flipped bit rejected", !imuBiasValid(corrupt));
+
+  corrupt = rec;
+  corrupt.magic = 0;
+  corrupt.crc = imuBiasRecordCrc(corrupt);
+  report("crc: wrong magic rejected", !imuBiasValid(corrupt));
+}
+
+void testRegisters() {
+  // Factory trim 0x1235 (bit 0 set), bias +100 counts
+  report("accel reg: trim minus bias", (accelOffsetRegister(0x1235, 100) & 0xFFFE) == 0x1235 - 100 - 1);
+  report("accel reg: reserved bit kept", (accelOffsetRegister(0x1235, 100) & 1) == 1);
+  report("accel reg: zero bias is trim", accelOffsetRegister(0xF00A, 0) == 0xF00A);
+  report("accel reg: clamped", accelOffsetRegister(0x7FF0, -1000) == 0x7FFE);
+  report("gyro reg: two LSB per count", gyroOffsetRegister(12) == (uint16_t)-24);
+  report("gyro reg: clamped", gyroOffsetRegister(-20000) == 0x7FFF);
+}
+
+void runTests() {
+  testLevelPad();
+  testRejected();
+  testRecordCrc();
+  testRegisters();
+}
+
+#ifdef ARDUINO
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println(F("========================================"));
+  Serial.println(F("IMU Bias Calibration Record Test"));
+  Serial.println(F("========================================"));
+
+  runTests();
+  Serial.println(failures == 0 ? F("ALL TESTS PASSED") : F("TESTS FAILED"));
+}
+
+void loop() {}
+#else
+int main() {
+  runTests();
+  printf("%s\n", failures == 0 ? "ALL TESTS PASSED" : "TESTS FAILED");
+  return failures == 0 ? 0 : 1;
+}
+#endif
@@ -0,0 +1,129 @@
+/*
+ * IMU Launch Detector Test
+ *
+ * Feeds simulated FIFO-rate accelerometer streams (raw counts at ±16 g)
+ * through include/launch_detect.h and checks when it latches.
+ *
+ * Test Scenarios:
+ * 1. Motor ignition at 1125 Hz: latched within LAUNCH_SUSTAIN_MS plus one
+ *    sample, with the launch time at the start of the boost
+ * 2. Pad noise and single-sample shocks (never latched)
+ * 3. Short bumps above threshold that end before the window
+ * 4. Launch along a tilted axis (magnitude, not Z)
+ * 5. Full-scale samples don't overflow the magnitude-squared sum
+ *
+ * No hardware required. Runs as a sketch (./run_test.sh) or on the host:
+ *   g++ -Iinclude -Iexamples examples/launch_detect/launch_detect_test.cpp -o launch_detect_test
+ */
+
+#include "test_report.h"
+#include "launch_detect.h"
+
+#define SAMPLE_US 889UL                 // 1125 Hz FIFO rate
+#define G LAUNCH_COUNTS_PER_G
+
+bool feed(LaunchDetector &det, int16_t x, int16_t y, int16_t z, unsigned long t) {
+  int16_t accel[3] = {x, y, z};
+  return launchDetectorUpdate(det, accel, t);
+}
+
+void testIgnition() {
+  LaunchDetector det;
+  resetLaunchDetector(det);
+  unsigned long t = 1000000UL;
+  unsigned long ignitionUs = 0;
+  unsigned long latchUs = 0;
+
+  for (int i = 0; i < 2000 && !latchUs; i++, t += SAMPLE_US) {
+    bool boost = i >= 1000;
+    if (boost && !ignitionUs) ignitionUs = t;
+    int16_t z = boost ? 8 * G : G;       // 8 g motor
+    if (feed(det, noise(40), noise(40), z + noise(40), t)) latchUs = t;
+  }
+
+  unsigned long latencyUs = latchUs - ignitionUs;
+#ifndef ARDUINO
+  printf("     latency %lu us\n", latencyUs);
+#endif
+  report("ignition: latched", det.launched);
+  report("ignition: latency within window + 1 sample", latencyUs <= LAUNCH_SUSTAIN_MS * 1000UL + SAMPLE_US);
+  report("ignition: latency at least the window", latencyUs >= LAUNCH_SUSTAIN_MS * 1000UL);
+  report("ignition: launch time at boost start", det.launchUs == ignitionUs);
+  report("ignition: latches once", !feed(det, 0, 0, 8 * G, t));
+}
+
+void testPadShocks() {
+  LaunchDetector det;
+  resetLaunchDetector(det);
+  unsigned long t = 0;
+
+  for (int i = 0; i < 20000; i++, t += SAMPLE_US) {
+    int16_t z = G + noise(200);
+    if (i % 997 == 0) z = 15 * G;        // Isolated shock
+    feed(det, noise(200), noise(200), z, t);
+  }
+  report("pad: noise and single shocks ignored", !det.launched);
+}
+
+void testShortBumps() {
+  LaunchDetector det;
+  resetLaunchDetector(det);
+  unsigned long t = 0;
+  unsigned long bumpSamples = (LAUNCH_SUSTAIN_MS * 1000UL) / SAMPLE_US - 1;
+
+  for (int bump = 0; bump < 50; bump++) {
+    for (unsigned long i = 0; i < bumpSamples; i++, t += SAMPLE_US) feed(det, 0, 0, 4 * G, t);
+    for (int i = 0; i < 20; i++, t += SAMPLE_US) feed(det, 0, 0, G, t);
+  }
+  report("bumps: shorter than the window ignored", !det.launched);
+}
+
+void testTiltedAxis() {
+  LaunchDetector det;
+  resetLaunchDetector(det);
+  unsigned long t = 0;
+
+  // 5 g along a diagonal: no single axis reaches 3 g
+  int16_t a = (int16_t)(5 * G / 1.732);
+  for (int i = 0; i < 100; i++, t += SAMPLE_US) feed(det, a, a, a, t);
+  report("tilted: magnitude latched", det.launched);
+}
+
+void testFullScale() {
+  int16_t big[3] = {-32768, -32768, -32768};
+  report("overflow: full scale magnitude^2", accelMagnitudeSq(big) == 3UL * 32768UL * 32768UL);
+  int16_t below[3] = {(int16_t)(LAUNCH_THRESHOLD_COUNTS - 1), 0, 0};
+  int16_t above[3] = {(int16_t)(LAUNCH_THRESHOLD_COUNTS + 1), 0, 0};
+  report("threshold: below", accelMagnitudeSq(below) <= LAUNCH_THRESHOLD_SQ);
+  report("threshold: above", accelMagnitudeSq(above) > LAUNCH_THRESHOLD_SQ);
+}
+
+void runTests() {
+  testIgnition();
+  testPadShocks();
+  testShortBumps();
+  testTiltedAxis();
+  testFullScale();
+}
+
+#ifdef ARDUINO
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println(F("========================================"));
+  Serial.println(F("IMU Launch Detector Test"));
+  Serial.println(F("========================================"));
+
+  runTests();
+  Serial.println(failures == 0 ? F("ALL TESTS PASSED") : F("TESTS FAILED"));
+}
+
+void loop() {}
+#else
+int main() {
+  runTests();
+  printf("%s\n", failures == 0 ? "ALL TESTS PASSED" : "TESTS FAILED");
+  return failures == 0 ? 0 : 1;
+}
+#endif
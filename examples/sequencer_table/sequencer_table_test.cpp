@@ -0,0 +1,329 @@
+/*
+ * Sequencer State Table Test
+ *
+ * Runs the flight table (src/sequencer_states.cpp) through the
+ * interpreter in include/sequencer_table.h with stub handlers standing in
+ * for sequencer.cpp: guards are flags the test sets, actions are recorded.
+ *
+ * Test Scenarios:
+ * 1. Every row points at a real state, names carry their state number
+ * 2. Every state is reachable from SBIT-0, only ABIT-16 is terminal
+ * 3. Nominal flight walks SBIT -> LBIT -> DBIT -> ABIT with the right
+ *    phases, each pyro entry runs exactly once
+ * 4. An SBIT check that never passes is retried SEQ_MAX_RETRIES times,
+ *    then reported exhausted
+ * 5. DBIT dwells (fairing, separation, final mode) are table timeouts,
+ *    each pyro fires once
+ * 6. Launch latches only when the loop pass drains the IMU FIFO, and the
+ *    pad wait leaves on the first tick after it
+ * 7. Motion ends pad idle ahead of the drain on the same loop pass; a
+ *    running pyro pulse is reported so loop() doesn't sleep
+ *
+ * Host only (links the table from src/):
+ *   g++ -Iinclude -Iexamples examples/sequencer_table/sequencer_table_test.cpp src/sequencer_states.cpp -o sequencer_table_test
+ */
+
+#include <string.h>
+#include "test_report.h"
+#include "sequencer_states.h"
+#include "config.h"
+
+#define TICK_MS 100   // SEQUENCER_UPDATE_RATE_MS
+
+// Stub handlers: guards read flags, actions count calls
+bool sensors, battery, payload, launched, clearOfPad, apogee, landed;
+int calls[32];
+enum {
+  A_CHECK_BATTERY, A_PAYLOAD_POWER, A_PAD_WAIT, A_PAD_SERVICE, A_LAUNCH, A_TRACK,
+  A_APOGEE_REPORT, A_FAIRING, A_SEPARATE, A_PAYLOAD, A_PARACHUTE, A_RECOVERY, A_SHUTDOWN,
+  A_PYRO_SERVICE, A_FIFO_DRAIN
+};
+
+bool sbitSensorsChecked() { return sensors; }
+void sbitCheckBattery() { calls[A_CHECK_BATTERY]++; }
+bool sbitBatteryOK() { return battery; }
+bool sbitSensorsOK() { return sensors; }
+void sbitPayloadPower() { calls[A_PAYLOAD_POWER]++; payload = true; }
+bool sbitPayloadOK() { return payload; }
+bool sbitPayloadTelemOK() { return payload && sensors; }
+bool sbitAllOK() { return battery && sensors && payload; }
+void lbitPadWait() { calls[A_PAD_WAIT]++; }
+void lbitPadService() { calls[A_PAD_SERVICE]++; }
+bool lbitLaunched() { return launched; }
+void lbitLaunch() { calls[A_LAUNCH]++; }
+bool lbitClearOfPad() { return clearOfPad; }
+void lbitTrackAscent() { calls[A_TRACK]++; }
+bool lbitApogee() { return apogee; }
+void lbitApogeeReport() { calls[A_APOGEE_REPORT]++; }
+void dbitPopFairing() { calls[A_FAIRING]++; }
+void dbitSeparateStage() { calls[A_SEPARATE]++; }
+void dbitDeployPayload() { calls[A_PAYLOAD]++; }
+void dbitDeployParachute() { calls[A_PARACHUTE]++; }
+void dbitRecoveryTelemetry() { calls[A_RECOVERY]++; }
+bool dbitLanded() { return landed; }
+void abitShutdown() { calls[A_SHUTDOWN]++; }
+
+// Stub IMU FIFO: boost samples wait here until serviceLaunchDetector()
+// drains them, which is the only place `launched` is set. The FIFO is
+// stopped while pad idle; motion restarts it.
+uint8_t fifoSamples;
+bool fifoBoost;
+bool padIdle, motion;
+uint8_t pulsesRunning;
+
+void servicePadWake() {
+  if (padIdle && motion) padIdle = false;
+}
+
+uint8_t servicePyroOutputs() {
+  calls[A_PYRO_SERVICE]++;
+  return pulsesRunning;
+}
+
+void serviceLaunchDetector() {
+  calls[A_FIFO_DRAIN]++;
+  if (padIdle) return;
+  if (fifoSamples && fifoBoost) launched = true;
+  fifoSamples = 0;
+}
+
+void queueBoost() {
+  fifoSamples = 16;
+  fifoBoost = true;
+}
+
+SeqMachine machine;
+unsigned long nowMs;
+uint8_t visited[SEQ_STATE_COUNT];
+uint8_t phaseAt[SEQ_STATE_COUNT];
+
+void recordTransition(const SeqMachine &m, uint8_t from, uint8_t fromPhase) {
+  (void)from;
+  (void)fromPhase;
+  visited[m.state]++;
+  phaseAt[m.state] = m.phase;
+}
+
+void start() {
+  sensors = battery = payload = launched = clearOfPad = apogee = landed = false;
+  fifoSamples = 0;
+  fifoBoost = padIdle = motion = false;
+  pulsesRunning = 0;
+  memset(calls, 0, sizeof(calls));
+  memset(visited, 0, sizeof(visited));
+  memset(phaseAt, 0xFF, sizeof(phaseAt));
+  nowMs = 1000;
+  machine.onTransition = recordTransition;
+  seqStart(machine, sequencerStates, SEQ_STATE_COUNT, SBIT_INIT_SEQ_IMU,
+           PHASE_STARTUP, SEQ_MAX_RETRIES, nowMs);
+  visited[SBIT_INIT_SEQ_IMU] = 1;
+  phaseAt[SBIT_INIT_SEQ_IMU] = machine.phase;
+}
+
+// One sequencer update as loop() runs it, inputs serviced first
+SeqResult tick() {
+  nowMs += TICK_MS;
+  serviceSequencerInputs();
+  return seqTick(machine, nowMs);
+}
+
+void ticks(int n) {
+  for (int i = 0; i < n; i++) tick();
+}
+
+void testTableConsistency() {
+  bool targetsOk = true;
+  bool namesOk = true;
+  for (uint8_t s = 0; s < SEQ_STATE_COUNT; s++) {
+    SeqStateDef row;
+    seqReadState(machine, s, row);
+    if (row.guard && row.next >= SEQ_STATE_COUNT) targetsOk = false;
+    if (row.timeoutMs && row.timeoutNext >= SEQ_STATE_COUNT) targetsOk = false;
+    if (row.phase != SEQ_NONE && row.phase >= SEQ_PHASE_COUNT) targetsOk = false;
+
+    char tag[8];
+    snprintf(tag, sizeof(tag), "-%u:", s);
+    const char *name = seqStateName(machine, s);
+    if (!name || !strstr(name, tag)) namesOk = false;
+  }
+  report("table: every transition targets a real state", targetsOk);
+  report("table: names match their state numbers", namesOk);
+  report("table: unknown state has no name", seqStateName(machine, SEQ_STATE_COUNT) == NULL);
+}
+
+void testReachability() {
+  bool reached[SEQ_STATE_COUNT] = {false};
+  reached[SBIT_INIT_SEQ_IMU] = true;
+  for (uint8_t pass = 0; pass < SEQ_STATE_COUNT; pass++) {
+    for (uint8_t s = 0; s < SEQ_STATE_COUNT; s++) {
+      if (!reached[s]) continue;
+      SeqStateDef row;
+      seqReadState(machine, s, row);
+      if (row.guard) reached[row.next] = true;
+      if (row.timeoutMs) reached[row.timeoutNext] = true;
+    }
+  }
+
+  bool allReached = true;
+  uint8_t terminal = 0, terminals = 0;
+  for (uint8_t s = 0; s < SEQ_STATE_COUNT; s++) {
+    if (!reached[s]) allReached = false;
+    SeqStateDef row;
+    seqReadState(machine, s, row);
+    if (!row.guard && !row.timeoutMs) {
+      terminal = s;
+      terminals++;
+    }
+  }
+  report("reach: every state reachable from SBIT-0", allReached);
+  report("reach: ABIT-16 is the only terminal state", terminals == 1 && terminal == ABIT_KILL_ALL_PROCESSES);
+}
+
+void testNominalFlight() {
+  start();
+  ticks(5);
+  report("flight: SBIT-0 waits for the sensor check", machine.state == SBIT_INIT_SEQ_IMU);
+
+  sensors = battery = true;
+  ticks(8);
+  report("flight: SBIT passes into the pad wait", machine.state == LBIT_IGNIT_BOOSTER &&
+         machine.phase == PHASE_PREFLIGHT && calls[A_PAD_WAIT] == 1 && calls[A_PAYLOAD_POWER] == 1);
+
+  int service = calls[A_PAD_SERVICE];
+  nowMs += 3600000UL;   // An hour on the pad: no timeout
+  ticks(10);
+  report("flight: pad wait ticks and never times out",
+         machine.state == LBIT_IGNIT_BOOSTER && calls[A_PAD_SERVICE] == service + 10);
+
+  queueBoost();
+  tick();
+  report("flight: launch enters LBIT-7 at once", machine.state == LBIT_LAUNCH &&
+         machine.phase == PHASE_LAUNCH && calls[A_LAUNCH] == 1);
+
+  clearOfPad = true;
+  ticks(3);
+  apogee = true;
+  ticks(130);  // Through the DBIT dwells
+  landed = true;
+  ticks(5);
+
+  bool allOnce = true;
+  for (uint8_t s = 0; s < SEQ_STATE_COUNT; s++) {
+    if (visited[s] != 1) allOnce = false;
+  }
+  report("flight: every state entered exactly once", allOnce);
+  report("flight: ends in ABIT-16 with one shutdown",
+         machine.state == ABIT_KILL_ALL_PROCESSES && calls[A_SHUTDOWN] == 1);
+  report("flight: each pyro entry ran once", calls[A_LAUNCH] == 1 && calls[A_FAIRING] == 1 &&
+         calls[A_SEPARATE] == 1 && calls[A_PAYLOAD] == 1 && calls[A_PARACHUTE] == 1);
+  report("flight: phases follow the states",
+         phaseAt[LBIT_POST_LAUNCH_REPORT] == PHASE_FLIGHT && phaseAt[DBIT_POP_NOSE_FAIRING] == PHASE_DEPLOY &&
+         phaseAt[DBIT_DEPLOY_PARACHUTE] == PHASE_DEPLOY && phaseAt[DBIT_SEND_ALL_TELEM] == PHASE_RECOVERY);
+
+  ticks(10);
+  report("flight: ABIT-16 stays put", machine.state == ABIT_KILL_ALL_PROCESSES && calls[A_SHUTDOWN] == 1);
+}
+
+void testStartupRetries() {
+  start();
+  sensors = true;
+  tick();
+  report("retry: at SBIT-1 with a low battery", machine.state == SBIT_STARTUP_BATTERY);
+
+  int retries = 0;
+  SeqResult last = SEQ_STAY;
+  unsigned long limit = nowMs + (SEQ_MAX_RETRIES + 2) * (unsigned long)STATE_TIMEOUT_MS;
+  while (nowMs < limit && last != SEQ_EXHAUSTED) {
+    last = tick();
+    if (last == SEQ_RETRY) retries++;
+  }
+  report("retry: retried SEQ_MAX_RETRIES times", retries == SEQ_MAX_RETRIES);
+  report("retry: then exhausted in the same state",
+         last == SEQ_EXHAUSTED && machine.state == SBIT_STARTUP_BATTERY);
+
+  start();
+  sensors = true;
+  tick();
+  nowMs += STATE_TIMEOUT_MS - 2 * TICK_MS;
+  battery = true;
+  tick();
+  report("retry: passing check resets the count", machine.state == SBIT_STARTUP_TELEM && machine.retries == 0);
+}
+
+// Time spent in `state` before the table moves on, in ms
+unsigned long dwellIn(uint8_t state) {
+  while (machine.state != state && nowMs < 1000000UL) tick();
+  unsigned long entered = machine.stateStartMs;
+  while (machine.state == state && nowMs < entered + 60000UL) tick();
+  return nowMs - entered;
+}
+
+bool dwellIs(unsigned long dwell, unsigned long expected) {
+  return dwell >= expected && dwell < expected + TICK_MS;
+}
+
+void testDeployDwells() {
+  start();
+  sensors = battery = clearOfPad = apogee = true;
+  queueBoost();
+  report("dwell: fairing clears for FAIRING_CLEAR_MS", dwellIs(dwellIn(DBIT_POP_NOSE_FAIRING), FAIRING_CLEAR_MS));
+  report("dwell: separation for STAGE_SEP_CLEAR_MS", dwellIs(dwellIn(DBIT_STAGE_SEPARATION), STAGE_SEP_CLEAR_MS));
+  report("dwell: final mode holds FINAL_MODE_HOLD_MS", dwellIs(dwellIn(DBIT_FINAL_MODE), FINAL_MODE_HOLD_MS));
+  report("dwell: each deploy pyro fired once", calls[A_FAIRING] == 1 && calls[A_SEPARATE] == 1 &&
+         calls[A_PAYLOAD] == 1 && calls[A_PARACHUTE] == 1);
+}
+
+void testLaunchDrain() {
+  start();
+  sensors = battery = true;
+  ticks(13);
+  report("drain: at the pad wait", machine.state == LBIT_IGNIT_BOOSTER);
+
+  int drains = calls[A_FIFO_DRAIN];
+  fifoSamples = 16;   // Pad handling: samples but no boost
+  ticks(10);
+  report("drain: FIFO drained every loop pass", calls[A_FIFO_DRAIN] == drains + 10 && fifoSamples == 0);
+  report("drain: quiet samples don't launch", machine.state == LBIT_IGNIT_BOOSTER && !launched);
+
+  queueBoost();
+  tick();
+  report("drain: boost in the FIFO latches launch", launched && fifoSamples == 0);
+  report("drain: LBIT-7 on the same tick", machine.state == LBIT_LAUNCH && calls[A_LAUNCH] == 1);
+  report("drain: pyro outputs serviced every pass", calls[A_PYRO_SERVICE] == calls[A_FIFO_DRAIN]);
+}
+
+void testPadWake() {
+  start();
+  sensors = battery = true;
+  ticks(13);
+  padIdle = true;
+  queueBoost();
+  ticks(3);
+  report("wake: FIFO stopped while pad idle", machine.state == LBIT_IGNIT_BOOSTER && !launched);
+
+  motion = true;
+  tick();
+  report("wake: motion, drain and launch in one pass", !padIdle && launched && machine.state == LBIT_LAUNCH);
+
+  pulsesRunning = 1;
+  report("wake: running pulse keeps loop() awake", serviceSequencerInputs());
+  pulsesRunning = 0;
+  report("wake: no pulse, free to sleep", !serviceSequencerInputs());
+}
+
+void runTests() {
+  start();
+  testTableConsistency();
+  testReachability();
+  testNominalFlight();
+  testStartupRetries();
+  testDeployDwells();
+  testLaunchDrain();
+  testPadWake();
+}
+
+int main() {
+  runTests();
+  printf("%s\n", failures == 0 ? "ALL TESTS PASSED" : "TESTS FAILED");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+/*
+ * Sequencer Telemetry Record Test
+ *
+ * Formats records with include/sequencer_telemetry.h while counting every
+ * malloc/calloc/realloc and operator new in the process.
+ *
+ * Test Scenarios:
+ * 1. A known record comes out column for column as the String version did
+ * 2. Float fields match printf rounding at 2 and 6 decimals
+ * 3. nan, inf and out-of-range values print as Print does
+ * 4. Zero heap allocations across 1000 records
+ * 5. A short buffer returns 0, stays terminated and isn't overrun
+ * 6. Extreme but plausible readings fit TELEMETRY_RECORD_MAX
+ *
+ * Host only (counts allocations by interposing glibc malloc):
+ *   g++ -Iinclude -Iexamples examples/sequencer_telemetry/sequencer_telemetry_test.cpp -o sequencer_telemetry_test
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_report.h"
+#include "sequencer_telemetry.h"
+
+// Heap allocation counter
+unsigned long allocations = 0;
+
+extern "C" void *__libc_malloc(size_t);
+extern "C" void *__libc_calloc(size_t, size_t);
+extern "C" void *__libc_realloc(void *, size_t);
+
+extern "C" void *malloc(size_t n) { allocations++; return __libc_malloc(n); }
+extern "C" void *calloc(size_t n, size_t m) { allocations++; return __libc_calloc(n, m); }
+extern "C" void *realloc(void *p, size_t n) { allocations++; return __libc_realloc(p, n); }
+void *operator new(size_t n) { allocations++; return __libc_malloc(n); }
+void *operator new[](size_t n) { allocations++; return __libc_malloc(n); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+const char stateName[] = "LBIT-8: Post Launch";
+const char phaseName[] = "FLIGHT";
+
+SequencerTelemetryData sample() {
+  SequencerTelemetryData d;
+  d.timestamp = 123456;
+  d.sequencerState = LBIT_POST_LAUNCH_REPORT;
+  d.missionPhase = PHASE_FLIGHT;
+  d.temperature = 21.5;
+  d.pressure = 0.0;
+  d.altitude = 312.25;
+  d.altitudeAGL = 45.75;
+  d.vertical_velocity = -1.5;
+  d.gps_lat = 34.71875;     // Exact in float
+  d.gps_lon = -86.59375;
+  d.gps_alt = 312.25;
+  d.gps_satellites = 7;
+  d.accel_x = 0.25;
+  d.accel_y = -0.5;
+  d.accel_z = 3.75;
+  d.accel_magnitude = 3.8125;
+  d.gyro_x = 0.0;
+  d.gyro_y = 0.0;
+  d.gyro_z = 0.0;
+  d.batteryOK = true;
+  d.sensorsOK = true;
+  d.payloadOK = false;
+  return d;
+}
+
+void testKnownRecord() {
+  char buf[TELEMETRY_RECORD_MAX];
+  SequencerTelemetryData d = sample();
+  size_t len = formatTelemetryRecord(buf, sizeof(buf), d, stateName, phaseName);
+  const char *expected =
+    "123456,8,LBIT-8: Post Launch,3,FLIGHT,21.50,0.00,312.25,45.75,-1.50,"
+    "34.718750,-86.593750,312.25,7,0.25,-0.50,3.75,3.81,0.00,0.00,0.00,OK,OK,FAIL";
+  report("record: columns match", strcmp(buf, expected) == 0 && len == strlen(expected));
+  if (strcmp(buf, expected) != 0) printf("     got %s\n", buf);
+
+  int commas = 0;
+  for (const char *p = buf; *p; p++) commas += *p == ',';
+  report("record: 24 fields", commas == 23);
+}
+
+void testFloatRounding() {
+  const double values[] = {0.0, 1.0, -1.0, 0.126, 2.994, 99.995001, -0.004, 1234.5678, 101325.0, -86.5856789};
+  bool ok2 = true, ok6 = true;
+  for (unsigned i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    char buf[32], ref[32];
+    RecordWriter w = {buf, sizeof(buf), 0, false};
+    recordPutFloat(w, values[i], 2);
+    snprintf(ref, sizeof(ref), "%.2f", values[i]);
+    if (strcmp(buf, ref) != 0) {
+      printf("     %.7f: %s vs %s\n", values[i], buf, ref);
+      ok2 = false;
+    }
+
+    w.len = 0;
+    recordPutFloat(w, values[i], 6);
+    snprintf(ref, sizeof(ref), "%.6f", values[i]);
+    if (strcmp(buf, ref) != 0) {
+      printf("     %.7f: %s vs %s\n", values[i], buf, ref);
+      ok6 = false;
+    }
+  }
+  report("floats: 2 decimals match printf", ok2);
+  report("floats: 6 decimals match printf", ok6);
+}
+
+void testSpecialValues() {
+  char buf[32];
+  RecordWriter w = {buf, sizeof(buf), 0, false};
+  recordPutFloat(w, NAN, 2);
+  recordPutChar(w, ' ');
+  recordPutFloat(w, -INFINITY, 2);
+  recordPutChar(w, ' ');
+  recordPutFloat(w, 5e9, 2);
+  report("special: nan inf ovf", strcmp(buf, "nan inf ovf") == 0);
+}
+
+void testNoAllocations() {
+  char buf[TELEMETRY_RECORD_MAX];
+  SequencerTelemetryData d = sample();
+  size_t total = 0;
+  unsigned long before = allocations;
+  for (int i = 0; i < 1000; i++) {
+    d.timestamp += 500;
+    d.altitude += 1.25;
+    d.vertical_velocity -= 0.03;
+    d.gps_satellites = i % 12;
+    total += formatTelemetryRecord(buf, sizeof(buf), d, stateName, phaseName);
+  }
+  unsigned long used = allocations - before;
+  printf("     1000 records, %lu bytes, %lu heap allocations\n", (unsigned long)total, used);
+  report("heap: zero allocations per record", used == 0 && total > 0);
+}
+
+void testShortBuffer() {
+  char buf[48];
+  memset(buf, 0x5A, sizeof(buf));
+  SequencerTelemetryData d = sample();
+  size_t len = formatTelemetryRecord(buf, 40, d, stateName, phaseName);
+  report("short: returns 0", len == 0);
+  report("short: terminated prefix", strlen(buf) == 39 && strncmp(buf, "123456,8,LBIT-8", 15) == 0);
+  bool intact = true;
+  for (size_t i = 40; i < sizeof(buf); i++) intact &= buf[i] == 0x5A;
+  report("short: nothing written past the buffer", intact);
+}
+
+void testWorstCase() {
+  char buf[TELEMETRY_RECORD_MAX];
+  SequencerTelemetryData d;
+  d.timestamp = 4294967295UL;
+  d.sequencerState = ABIT_KILL_ALL_PROCESSES;
+  d.missionPhase = PHASE_PREFLIGHT;
+  d.temperature = d.pressure = d.altitude = d.altitudeAGL = d.vertical_velocity = -99999.99;
+  d.gps_lat = -89.999999;
+  d.gps_lon = -179.999999;
+  d.gps_alt = -99999.99;
+  d.gps_satellites = 99;
+  d.accel_x = d.accel_y = d.accel_z = d.accel_magnitude = -99999.99;
+  d.gyro_x = d.gyro_y = d.gyro_z = -99999.99;
+  d.batteryOK = d.sensorsOK = d.payloadOK = false;
+  size_t len = formatTelemetryRecord(buf, sizeof(buf), d, "ABIT-16: Kill All Processes", "PREFLIGHT");
+  printf("     worst case %lu of %d bytes\n", (unsigned long)len, TELEMETRY_RECORD_MAX);
+  report("worst: fits TELEMETRY_RECORD_MAX", len > 0);
+}
+
+void runTests() {
+  testKnownRecord();
+  testFloatRounding();
+  testSpecialValues();
+  testNoAllocations();
+  testShortBuffer();
+  testWorstCase();
+}
+
+int main() {
+  runTests();
+  printf("%s\n", failures == 0 ? "ALL TESTS PASSED" : "TESTS FAILED");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+/*
+ * Shared test reporting
+ * PASS/FAIL lines and the failure count for the examples/<name>/<name>_test.cpp
+ * suites, on Serial as a sketch and printf on the host, plus deterministic
+ * noise so every run feeds the code under test the same samples.
+ *
+ * Each test is a single translation unit that includes this once.
+ * Host builds add -Iexamples; ./run_test.sh adds it for the sketch build.
+ */
+
+#ifndef TEST_REPORT_H
+#define TEST_REPORT_H
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <stdio.h>
+#endif
+#include <stdint.h>
+
+int failures = 0;
+
+void report(const char* name, bool pass) {
+#ifdef ARDUINO
+  Serial.print(pass ? F("✓ PASS ") : F("✗ FAIL "));
+  Serial.println(name);
+#else
+  printf("%s %s\n", pass ? "PASS" : "FAIL", name);
+#endif
+  if (!pass) failures++;
+}
+
+// Same LCG sequence every run, top 16 bits of the state
+uint16_t testRandom() {
+  static uint32_t seed = 12345;
+  seed = seed * 1103515245UL + 12345UL;
+  return (uint16_t)(seed >> 16);
+}
+
+// Deterministic noise in [-amplitude, amplitude], sensor counts
+int16_t noise(int16_t amplitude) {
+  return (int16_t)((int32_t)(testRandom() % (2 * amplitude + 1)) - amplitude);
+}
+
+// Deterministic noise in [-amplitude, amplitude], continuous
+float noiseF(float amplitude) {
+  return amplitude * ((testRandom() & 0x7FFF) / 16383.5 - 1.0);
+}
+
+#endif // TEST_REPORT_H
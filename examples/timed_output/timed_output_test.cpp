@@ -0,0 +1,131 @@
+/*
+ * Timed Output Test
+ *
+ * Drives include/timed_output.h with a simulated millisecond clock and a
+ * recording pin writer in place of digitalWrite.
+ *
+ * Test Scenarios:
+ * 1. A pulse goes high at once and low on the first service at its deadline
+ * 2. Overlapping pulses on different pins end independently
+ * 3. Re-firing a pin mid-pulse keeps the original deadline
+ * 4. A sixth pin is refused without touching it when all slots are busy
+ * 5. Cancel drops every running pulse
+ * 6. Deadlines survive the millis() rollover
+ *
+ * No hardware required. Runs as a sketch (./run_test.sh) or on the host:
+ *   g++ -Iinclude -Iexamples examples/timed_output/timed_output_test.cpp -o timed_output_test
+ */
+
+#include "test_report.h"
+#include "timed_output.h"
+
+// Pin levels and write counts as the outputs would see them
+uint8_t level[32];
+uint8_t writes[32];
+
+void recordWrite(uint8_t pin, uint8_t value) {
+  level[pin] = value;
+  writes[pin]++;
+}
+
+TimedOutputs outs;
+
+void reset() {
+  for (uint8_t i = 0; i < 32; i++) level[i] = writes[i] = 0;
+  initTimedOutputs(outs, recordWrite);
+}
+
+// Services every millisecond from `from` to `to`, returns when pin dropped
+unsigned long runUntilLow(uint8_t pin, unsigned long from, unsigned long to) {
+  for (unsigned long t = from; t != to; t++) {
+    timedOutputService(outs, t);
+    if (!level[pin]) return t;
+  }
+  return to;
+}
+
+void testSinglePulse() {
+  reset();
+  bool ok = timedOutputPulse(outs, 2, 100, 1000);
+  report("pulse: pin high immediately", ok && level[2] == 1);
+  unsigned long off = runUntilLow(2, 1000, 2000);
+  report("pulse: low at the 100 ms deadline", off == 1100 && writes[2] == 2);
+  report("pulse: nothing left running", timedOutputService(outs, 2000) == 0);
+}
+
+void testOverlap() {
+  reset();
+  timedOutputPulse(outs, 2, 100, 0);
+  timedOutputPulse(outs, 4, 100, 50);
+  timedOutputService(outs, 100);
+  report("overlap: first ends on time", level[2] == 0 && level[4] == 1);
+  timedOutputService(outs, 149);
+  report("overlap: second still running", level[4] == 1);
+  timedOutputService(outs, 150);
+  report("overlap: second ends on time", level[4] == 0);
+}
+
+void testRefire() {
+  reset();
+  timedOutputPulse(outs, 5, 100, 0);
+  timedOutputPulse(outs, 5, 100, 80);
+  unsigned long off = runUntilLow(5, 0, 1000);
+  report("refire: original deadline kept", off == 100 && writes[5] == 2);
+}
+
+void testFull() {
+  reset();
+  for (uint8_t pin = 1; pin <= TIMED_OUTPUT_SLOTS; pin++) timedOutputPulse(outs, pin, 100, 0);
+  bool ok = timedOutputPulse(outs, 20, 100, 0);
+  report("full: extra pin refused", !ok && writes[20] == 0);
+  timedOutputService(outs, 100);
+  report("full: slot free again after the pulses", timedOutputPulse(outs, 20, 100, 100) && level[20] == 1);
+}
+
+void testCancel() {
+  reset();
+  timedOutputPulse(outs, 2, 1000, 0);
+  timedOutputPulse(outs, 4, 1000, 0);
+  timedOutputCancelAll(outs);
+  report("cancel: pins low", level[2] == 0 && level[4] == 0);
+  report("cancel: nothing left running", timedOutputService(outs, 1) == 0 && writes[2] == 2);
+}
+
+void testRollover() {
+  reset();
+  unsigned long start = 0xFFFFFFFFUL - 40;
+  timedOutputPulse(outs, 3, 100, start);
+  unsigned long off = runUntilLow(3, start, start + 1000);
+  report("rollover: deadline across the wrap", off == start + 100);
+}
+
+void runTests() {
+  testSinglePulse();
+  testOverlap();
+  testRefire();
+  testFull();
+  testCancel();
+  testRollover();
+}
+
+#ifdef ARDUINO
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println(F("========================================"));
+  Serial.println(F("Timed Output Test"));
+  Serial.println(F("========================================"));
+
+  runTests();
+  Serial.println(failures == 0 ? F("ALL TESTS PASSED") : F("TESTS FAILED"));
+}
+
+void loop() {}
+#else
+int main() {
+  runTests();
+  printf("%s\n", failures == 0 ? "ALL TESTS PASSED" : "TESTS FAILED");
+  return failures == 0 ? 0 : 1;
+}
+#endif
@@ -3,14 +3,47 @@
 
 #include <Arduino.h>
 
+// Acquisition mode: free-running normal mode, or one forced conversion per
+// BARO_TICK_MS collected on the following tick
+enum BaroMode {
+  BARO_MODE_NORMAL,
+  BARO_MODE_FORCED
+};
+
 struct BaroData {
   float temperature;
   float pressure;
-  float altitude;
+  float altitude;     // Standard atmosphere (1013.25 hPa)
+  float altitudeAGL;  // Relative to pad reference, 0 until calibrated
+  float sampleRateHz; // Effective rate of fresh samples
+  unsigned long sampleMicros; // Conversion start (forced) or read time (normal)
+  long jitterUs;      // Forced mode: lateness of the tick that collected it
+  uint16_t rejectedCount; // Samples dropped by the innovation gate so far
+  bool fresh;         // New conversion since the previous readBaro()
   bool dataValid;
 };
 
-bool initBaro();
+// Streaming noise/health statistics, updated on every fresh sample
+struct BaroStats {
+  uint16_t count;
+  float pressureMean;
+  float pressureStdDev;
+  float temperatureMean;
+  float temperatureStdDev;
+};
+
+bool initBaro(BaroMode mode = BARO_MODE_NORMAL);
 bool readBaro(BaroData &data);
+unsigned long baroUsUntilTick();  // Forced mode only, else 0xFFFFFFFF
+void setBaroIdle(bool idle);      // Pad idle: forced conversion every BARO_IDLE_TICK_MS
+void getBaroStats(BaroStats &stats);
+void resetBaroStats();
+
+// Pad reference pressure: averaged on the pad, tracked slowly while
+// disarmed, frozen while armed
+void armBaro();
+void disarmBaro();
+bool isBaroCalibrated();
+float getBaroReferencePressure();
 
-#endif
\ No newline at end of file
+#endif
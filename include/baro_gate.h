@@ -0,0 +1,98 @@
+/*
+ * Barometer innovation gate
+ * Rejects pressure spikes (ejection charges, transonic airflow) that pass the
+ * absolute range check but disagree with the predicted altitude.
+ *
+ * Header-only and free of Arduino dependencies so the same code runs in
+ * examples/baro_gate/baro_gate_test.cpp on the host.
+ */
+
+#ifndef BARO_GATE_H
+#define BARO_GATE_H
+
+#include <stdint.h>
+#include "config.h"
+
+struct BaroGate {
+  float altitude;              // Tracked altitude (m)
+  float velocity;              // Tracked vertical velocity (m/s)
+  float acceleration;          // Tracked vertical acceleration (m/s^2)
+  float innovationVar;         // Running innovation variance (m^2)
+  float firstRejected;         // Measurement that started the current reject run
+  uint8_t consecutiveRejects;
+  uint16_t acceptedCount;
+  uint16_t rejectedCount;
+  bool initialized;
+};
+
+inline void resetBaroGate(BaroGate &gate) {
+  gate.altitude = 0.0;
+  gate.velocity = 0.0;
+  gate.acceleration = 0.0;
+  gate.innovationVar = BARO_GATE_SIGMA_MIN_M * BARO_GATE_SIGMA_MIN_M;
+  gate.firstRejected = 0.0;
+  gate.consecutiveRejects = 0;
+  gate.acceptedCount = 0;
+  gate.rejectedCount = 0;
+  gate.initialized = false;
+}
+
+// Returns true if the altitude sample (m) is consistent with the alpha-beta-
+// gamma prediction over dt seconds. Compares squared values, no sqrt.
+inline bool baroGateAccept(BaroGate &gate, float altitude, float dt) {
+  if (!gate.initialized) {
+    gate.altitude = altitude;
+    gate.initialized = true;
+    gate.acceptedCount++;
+    return true;
+  }
+
+  float predicted = gate.altitude + (gate.velocity + 0.5 * gate.acceleration * dt) * dt;
+  float predictedVel = gate.velocity + gate.acceleration * dt;
+  float innovation = altitude - predicted;
+  float innovation2 = innovation * innovation;
+
+  // K sigma plus what an unmodelled BARO_GATE_MANEUVER_ACCEL could add over dt
+  float margin = 0.5 * BARO_GATE_MANEUVER_ACCEL * dt * dt;
+  float limit = BARO_GATE_K_SIGMA * BARO_GATE_K_SIGMA * gate.innovationVar;
+  limit += margin * margin;
+
+  if (innovation2 > limit) {
+    if (gate.consecutiveRejects < BARO_GATE_MAX_REJECTS) {
+      if (gate.consecutiveRejects == 0) gate.firstRejected = altitude;
+      gate.consecutiveRejects++;
+      gate.rejectedCount++;
+      gate.altitude = predicted;  // Coast on the prediction
+      gate.velocity = predictedVel;
+      return false;
+    }
+
+    // A run of rejections means the vehicle really moved: re-seed on the
+    // data without letting the jump inflate the innovation variance
+    gate.velocity = (altitude - gate.firstRejected) / (dt * gate.consecutiveRejects);
+    gate.acceleration = 0.0;
+    gate.altitude = altitude;
+    gate.consecutiveRejects = 0;
+    gate.acceptedCount++;
+    return true;
+  }
+
+  gate.consecutiveRejects = 0;
+  gate.acceptedCount++;
+
+  // Alpha-beta-gamma tracker update
+  gate.altitude = predicted + BARO_GATE_ALPHA * innovation;
+  gate.velocity = predictedVel;
+  if (dt > 0.0) {
+    gate.velocity += BARO_GATE_BETA * innovation / dt;
+    gate.acceleration += 2.0 * BARO_GATE_GAMMA * innovation / (dt * dt);
+  }
+
+  gate.innovationVar += (innovation2 - gate.innovationVar) / 16.0;
+  float minVar = BARO_GATE_SIGMA_MIN_M * BARO_GATE_SIGMA_MIN_M;
+  if (gate.innovationVar < minVar) gate.innovationVar = minVar;
+
+  return true;
+}
+
+#endif // BARO_GATE_H
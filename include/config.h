@@ -9,6 +9,28 @@
 
 // IMU Configuration (ICM-20948)
 #define IMU_CS_PIN 6    // SPI CS IMU (sen_cs)
+#define IMU_INT_PIN 3   // ICM-20948 INT1 raw data ready (D3 = INT1)
+#define IMU_SPI_FREQ 7000000    // ICM-20948 max; 16 MHz AVR rounds down to 4 MHz (F_CPU/4)
+#define IMU_SPI_CHECK_READS 200 // WHO_AM_I reads for validateIMUSpi() at initIMU()
+#define IMU_SPI_FALLBACK_FREQ 1000000  // Used when IMU_SPI_FREQ shows mismatches
+#define IMU_SMPLRT_DIV 62       // Single-sample ODR = 1125 Hz / (1 + div), ~18 Hz: at most one per 50 ms logger pass
+#define IMU_FIFO_SMPLRT_DIV 0   // FIFO mode ODR = 1125 Hz / (1 + div)
+#define IMU_FIFO_BATCH 8        // Samples drained per burst read (12 bytes each)
+#define IMU_FIFO_MAX_BLOCKS 6   // Burst reads per serviceLaunchDetector(): a full FIFO (42 samples)
+#define IMU_DMP_ODR_DIV 0       // DMP mode: quaternion/accel every (1 + div) DMP cycles (55 Hz base)
+#define IMU_MAG_MODE AK09916_mode_cont_20hz  // Magnetometer rate (calibration: tools/mag_calibrate.py)
+#define IMU_MAG_FETCH_HZ 20     // ICM I2C master mag fetch rate target (delay set per ODR)
+#define IMU_MAG_LOG_MS 50       // Calibrated MAG row interval while logging (20 Hz mag)
+
+// IMU bias calibration (level pad, stored in EEPROM, see imu_bias.h)
+#define IMU_BIAS_EEPROM_ADDR 0        // IMUBiasRecord, 15 bytes
+#define IMU_BIAS_SAMPLES 256          // Samples averaged by calibrateIMUBias()
+#define IMU_BIAS_LEVEL_TOL 205        // Max accel bias, counts at ±16 g (0.1 g)
+#define IMU_BIAS_GYRO_TOL 164         // Max gyro bias, counts at ±2000 dps (10 dps)
+
+// RTC Configuration (PCF8523)
+#define RTC_INT_PIN 2   // PCF8523 INT1, 1 Hz second tick (D2 = INT0)
+#define RTC_CAL_MODE RTC_OFFSET_TWO_HOURS  // Offset mode used by the 'O' command (tools/rtc_calibrate.py)
 
 // Barometer Configuration (BMP280)
 // #define BARO_CS_PIN 3    // SPI CS BARO (bmp_cs)
@@ -30,6 +52,11 @@
 #define SEQUENCER_UPDATE_RATE_MS 100  // 10Hz sequencer updates
 #define FAST_TELEM_RATE_MS 500        // 2Hz during critical phases (0.5s)
 #define NORMAL_TELEM_RATE_MS 500      // 2Hz during normal operations (0.5s)
+#define PYRO_PULSE_MS 100             // Pyro channel on-time (timed_output.h, not a delay)
+#define FAIRING_CLEAR_MS 2000         // DBIT-10 dwell: let the fairing clear
+#define STAGE_SEP_CLEAR_MS 3000       // DBIT-11 dwell: let the stages separate
+#define FINAL_MODE_HOLD_MS 5000       // DBIT-13 dwell before the parachute
+#define LANDED_LOG_MS 30000           // DBIT-15: keep logging this long after landing
 
 
 // Launch detection
@@ -37,6 +64,42 @@
 #define APOGEE_VELOCITY_THRESHOLD -2.0 // Negative velocity for apogee
 #define LANDING_VELOCITY_THRESHOLD 5.0 // Low velocity for landing detection
 #define MINIMUM_FLIGHT_ALTITUDE_M 30.0 // Minimum altitude to be considered flight
+#define LAUNCH_SUSTAIN_MS 10           // IMU launch: above threshold this long (launch_detect.h)
+#define LAUNCH_SUSTAIN_MIN_SAMPLES 5   // ...and for this many samples (needs >= 500 Hz)
+
+// Timebase (RTC anchored to millis())
+#define TIMEBASE_RESYNC_MS 60000      // Re-sync against the RTC once a minute
+#define TIMEBASE_USE_RTC_TICK true    // Discipline micros() with the RTC 1 Hz tick
+#define TIMEBASE_MAX_DRIFT_PPM 20000  // Tick periods further off are glitches
+
+// Barometer acquisition
+#define BARO_FORCED_MODE false        // true = forced conversions locked to BARO_TICK_MS
+#define BARO_TICK_MS 100              // Forced-mode tick (must exceed ~44 ms max t_meas)
+
+// Pad idle (IMU wake-on-motion, slow baro, MCU idle sleep; see pad_idle.h)
+#define IMU_WOM_THRESHOLD_MG 200      // Sample-to-sample accel change that wakes (4 mg steps, max 1020)
+#define IMU_WOM_SMPLRT_DIV 44         // Low-power accel ODR = 1125 Hz / (1 + div), 25 Hz
+#define BARO_IDLE_TICK_MS 2000        // Forced conversion interval while idle
+#define PAD_IDLE_REARM_MS 60000       // Quiet time after a wake before idling again
+
+// Barometer pad calibration (ground reference pressure)
+#define BARO_CAL_SAMPLES 16           // Samples averaged for the pad reference
+#define BARO_CAL_REJECT_HPA 0.5       // Reject cal samples this far from the median
+#define BARO_REF_TRACK_DIV 64.0       // Slow reference tracking while disarmed (EMA 1/N)
+
+// Barometer health statistics (streaming mean/variance)
+#define BARO_STATS_WINDOW 64          // Sample count at which old samples start fading
+#define BARO_STATS_MIN_SAMPLES 8      // Samples required before health is judged
+#define BARO_NOISE_MAX_HPA 0.5        // Max pressure std dev for a healthy baro
+
+// Barometer innovation gate (spike rejection against predicted altitude)
+#define BARO_GATE_K_SIGMA 4.0         // Reject samples beyond K sigma of the prediction
+#define BARO_GATE_SIGMA_MIN_M 1.0     // Innovation sigma floor (m)
+#define BARO_GATE_MANEUVER_ACCEL 100.0 // Unmodelled accel allowed between samples (m/s^2)
+#define BARO_GATE_MAX_REJECTS 3       // Consecutive rejects before following the data
+#define BARO_GATE_ALPHA 0.875         // Alpha-beta-gamma gains (critically damped, theta 0.5)
+#define BARO_GATE_BETA 0.5625
+#define BARO_GATE_GAMMA 0.0625
 
 // Legacy flight detection (for compatibility with existing code)
 #define ALTITUDE_RISE_THRESHOLD_M 10.0   // Altitude increase to detect flight start
@@ -65,6 +128,7 @@
 
 #define SERIAL_BAUD_RATE 115200
 #define ENABLE_SERIAL_DEBUG true
+#define ERROR_REPORT_INTERVAL_MS 5000  // Min spacing of driver error reports (error_log.h)
 
 // ============================================================================
 // ERROR HANDLING
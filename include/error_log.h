@@ -0,0 +1,38 @@
+#ifndef ERROR_LOG_H
+#define ERROR_LOG_H
+
+#include <Arduino.h>
+
+// Shared fault table: drivers call recordError() from the sample loop (no
+// Serial I/O), and reportErrors() prints what changed at a limited rate.
+
+enum ErrorSource {
+  ERR_RTC_I2C,          // code = Wire.endTransmission() status
+  ERR_RTC_SHORT_READ,   // code = bytes received
+  ERR_RTC_RANGE,        // code = raw seconds register
+  ERR_BARO_INVALID,     // code = 1 once retried, 2 if the retry also failed
+  ERR_SD_NOT_LOGGING,
+  ERR_SD_NOT_OPEN,
+  ERR_SD_WRITE,         // code = File::getWriteError()
+  ERR_IMU_FIFO_OVERFLOW, // code = FIFO count / 16 when it was reset
+  ERR_IMU_OVERRUN,      // code = data-ready edges since the last readIMU()
+  ERR_IMU_BIAS,         // code = 1 bad EEPROM record, 2 offset write failed
+  ERR_IMU_INT,          // Data-ready interrupt not enabled, reads poll instead
+  ERR_IMU_SPI,          // code = WHO_AM_I mismatches at IMU_SPI_FREQ (fell back)
+  ERR_SOURCE_COUNT
+};
+
+struct ErrorEntry {
+  uint16_t count;       // Saturates at 0xFFFF
+  uint8_t lastCode;
+  unsigned long lastMillis;
+};
+
+void recordError(ErrorSource source, uint8_t code = 0);
+uint16_t getErrorCount(ErrorSource source);
+const ErrorEntry& getErrorEntry(ErrorSource source);
+void reportErrors();    // Call every loop; prints new errors every ERROR_REPORT_INTERVAL_MS
+void printErrors();     // Print every non-zero entry now
+void clearErrors();
+
+#endif // ERROR_LOG_H
@@ -17,7 +17,10 @@
 
 // Flight detection functions
 void updateFlightDetection();
-bool detectLaunch();
+void serviceLaunchDetector();         // Call every loop: runs each IMU FIFO sample through the detector
+bool detectLaunch();                  // Latched by serviceLaunchDetector()
+unsigned long getLaunchMicros();      // micros() when the sustained boost began
+void getLatestAccel(float &x, float &y, float &z);  // Newest FIFO sample (g)
 bool detectApogee();
 bool detectLanding();
 float calculateVerticalVelocity();
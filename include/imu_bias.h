@@ -0,0 +1,88 @@
+/*
+ * ICM-20948 bias calibration record
+ * Biases measured on a level pad are kept in EEPROM and written to the
+ * chip's own offset registers at boot, so every sample (polled, FIFO or
+ * DMP) comes out corrected with no work in the read path.
+ *
+ * Header-only and free of Arduino dependencies so the same code runs in
+ * examples/imu_bias/imu_bias_test.cpp on the host.
+ */
+
+#ifndef IMU_BIAS_H
+#define IMU_BIAS_H
+
+#include <stdint.h>
+#include "config.h"
+
+#define IMU_BIAS_MAGIC 0xB1A5
+#define IMU_BIAS_ONE_G 2048           // Accel counts per g at ±16 g
+
+// Biases in raw counts at ±16 g / ±2000 dps (the initIMU() full scale)
+struct IMUBiasRecord {
+  uint16_t magic;
+  int16_t accel[3];
+  int16_t gyro[3];
+  uint8_t crc;                        // CRC-8 of everything above
+};
+
+// CRC-8, polynomial 0x07 (as SMBus PEC)
+inline uint8_t imuBiasCrc(const uint8_t *data, uint8_t len) {
+  uint8_t crc = 0;
+  while (len--) {
+    crc ^= *data++;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+inline uint8_t imuBiasRecordCrc(const IMUBiasRecord &rec) {
+  return imuBiasCrc((const uint8_t *)&rec, (uint8_t)((const uint8_t *)&rec.crc - (const uint8_t *)&rec));
+}
+
+// Blank (0xFF) or corrupted EEPROM fails here
+inline bool imuBiasValid(const IMUBiasRecord &rec) {
+  return rec.magic == IMU_BIAS_MAGIC && rec.crc == imuBiasRecordCrc(rec);
+}
+
+// Turn sample sums from a level, still pad (Z up) into a record. Fails if
+// the board isn't level or the gyro means look like motion.
+inline bool computeIMUBias(const int32_t accelSum[3], const int32_t gyroSum[3],
+                           uint16_t samples, IMUBiasRecord &rec) {
+  if (samples == 0) return false;
+
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    int32_t accel = accelSum[axis] / samples;
+    int32_t gyro = gyroSum[axis] / samples;
+    if (axis == 2) accel -= IMU_BIAS_ONE_G;
+    if (accel > IMU_BIAS_LEVEL_TOL || accel < -IMU_BIAS_LEVEL_TOL) return false;
+    if (gyro > IMU_BIAS_GYRO_TOL || gyro < -IMU_BIAS_GYRO_TOL) return false;
+    rec.accel[axis] = (int16_t)accel;
+    rec.gyro[axis] = (int16_t)gyro;
+  }
+
+  rec.magic = IMU_BIAS_MAGIC;
+  rec.crc = imuBiasRecordCrc(rec);
+  return true;
+}
+
+// XA_OFFS: 15-bit value in bits 15:1 at 0.98 mg/LSB, i.e. one ±16 g count
+// per unit of the 16-bit register. Starts from the factory trim; bit 0 is
+// reserved and kept.
+inline uint16_t accelOffsetRegister(uint16_t factory, int16_t bias) {
+  int32_t value = (int16_t)factory - (int32_t)bias;
+  if (value > 32767) value = 32767;
+  if (value < -32768) value = -32768;
+  return ((uint16_t)value & 0xFFFE) | (factory & 0x0001);
+}
+
+// XG_OFFS_USR: 32.8 LSB/dps regardless of FS_SEL, two per ±2000 dps count
+inline uint16_t gyroOffsetRegister(int16_t bias) {
+  int32_t value = -2 * (int32_t)bias;
+  if (value > 32767) value = 32767;
+  if (value < -32768) value = -32768;
+  return (uint16_t)value;
+}
+
+#endif // IMU_BIAS_H
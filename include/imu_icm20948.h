@@ -2,6 +2,9 @@
 #define IMU_ICM20948_H
 
 #include <Arduino.h>
+#include "config.h"
+#include "imu_bias.h"
+#include "imu_mag.h"
 // #include "ICM_20948.h"
 
 // IMU data structure
@@ -10,19 +13,95 @@ struct IMUData {
   float gyro_x, gyro_y, gyro_z;     // rad/s
   float mag_x, mag_y, mag_z;        // µT
   float temperature;                // °C
+  unsigned long sampleMicros;       // Data-ready edge (or read time when polling)
   bool dataValid;
 };
 
+// Raw counts as read (ICM_20948_AGMT_t), scaled on the host by
+// tools/decode_log.py. fullScale = (accel FS_SEL << 2) | gyro FS_SEL.
+// mag is uncalibrated so logs can be re-fitted by tools/mag_calibrate.py.
+struct IMURawData {
+  int16_t accel[3];
+  int16_t gyro[3];
+  int16_t mag[3];                   // 0.15 µT/LSB
+  int16_t temperature;              // °C = raw / 333.87 + 21
+  uint8_t fullScale;
+  unsigned long sampleMicros;
+  bool dataValid;
+};
+
+// Block of FIFO samples (raw counts: ±16 g, ±2000 dps), oldest first
+struct IMUBlock {
+  unsigned long firstSampleUs;      // Estimated micros() of sample 0
+  uint16_t periodUs;                // Sample spacing
+  uint8_t count;
+  int16_t accel[IMU_FIFO_BATCH][3];
+  int16_t gyro[IMU_FIFO_BATCH][3];
+};
+
+// DMP orientation (game rotation vector, no magnetometer) and gravity-free
+// acceleration, both in the sensor frame. The DMP runs the accel at ±4 g.
+struct IMUAttitude {
+  float qw, qx, qy, qz;             // Unit quaternion
+  float linAccel_x, linAccel_y, linAccel_z;  // m/s², gravity removed
+  unsigned long sampleMicros;       // Time the quaternion was read
+  bool dataValid;
+};
+
+// Bus time per IMU read (readIMURaw/readIMUBlock/readIMUAttitude), for
+// comparing SPI clocks and batching against the SD card's share of the bus
+struct IMUBusStats {
+  uint32_t reads;
+  uint32_t totalUs;
+  uint16_t maxUs;
+  uint32_t transactions;            // Register accesses (CS assertions)
+  uint32_t bytes;
+};
+
+// Cost of the last startIMUDmp(), DMP firmware load and verify included
+struct IMUDmpStartStats {
+  uint32_t totalUs;
+  uint32_t transactions;
+  uint32_t bytes;
+};
+
 // Function prototypes
 bool initIMU();
-bool readIMU(IMUData &data);
+uint16_t validateIMUSpi(uint16_t reads);  // WHO_AM_I mismatches at IMU_SPI_FREQ
+void getIMUBusStats(IMUBusStats &stats);
+void resetIMUBusStats();
+uint32_t getIMUSpiFreq();            // IMU_SPI_FREQ, or IMU_SPI_FALLBACK_FREQ if it failed validation
+
+// Bias calibration: initIMU() reloads the EEPROM record into the offset registers
+bool calibrateIMUBias();   // Board level and still, Z up; stores and applies the result
+bool imuBiasLoaded();
+void getIMUBias(IMUBiasRecord &rec);
+bool readIMU(IMUData &data);         // readIMURaw() + convertIMU()
+bool readIMURaw(IMURawData &raw);
+bool readIMUMag(int16_t mag[3]);     // Hard/soft-iron corrected counts (0.15 uT/LSB), FIFO-mode safe
+bool enableIMUInterrupt();   // Data-ready on IMU_INT_PIN replaces dataReady() polling
+bool imuDataPending();
+
+// FIFO-batched acquisition: accel + gyro at 1125 / (1 + IMU_FIFO_SMPLRT_DIV) Hz
+bool startIMUFifo();
+void stopIMUFifo();
+bool readIMUBlock(IMUBlock &block);  // Drains up to IMU_FIFO_BATCH samples in one burst
+
+// Wake-on-motion (pad idle): accel duty-cycled at IMU_WOM_SMPLRT_DIV, gyro
+// off, INT1 latched on motion. Disarming restores FIFO/data-ready mode.
+bool armIMUWakeOnMotion();
+bool disarmIMUWakeOnMotion();
+bool imuMotionDetected();
+
+// DMP mode (build with -DICM_20948_USE_DMP, +14 KB flash for the DMP image)
+bool startIMUDmp();
+void getIMUDmpStartStats(IMUDmpStartStats &stats);
+bool readIMUAttitude(IMUAttitude &att);  // Drains queued DMP frames, returns the newest
 void printIMUData(const IMUData &data);
 bool isIMUConnected();
 
-// Conversion functions
-float convertAccel(int16_t raw);
-float convertGyro(int16_t raw);
-float convertMag(int16_t raw);
-float convertTemp(int16_t raw);
+// Conversion (only for on-board use; logs keep the raw counts). Applies
+// the magnetometer calibration from mag_cal.h.
+void convertIMU(const IMURawData &raw, IMUData &data);
 
 #endif // IMU_ICM20948_H
\ No newline at end of file
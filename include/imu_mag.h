@@ -0,0 +1,42 @@
+/*
+ * Magnetometer hard/soft-iron correction
+ * m' = S (m - b): b (raw counts) and S (Q12) come from the ellipsoid fit in
+ * tools/mag_calibrate.py, which writes include/mag_cal.h. Integer only;
+ * the result stays in AK09916 counts (0.15 uT/LSB).
+ *
+ * Header-only and free of Arduino dependencies so the same code runs in
+ * examples/imu_mag/imu_mag_test.cpp on the host.
+ */
+
+#ifndef IMU_MAG_H
+#define IMU_MAG_H
+
+#include <stdint.h>
+#include "mag_cal.h"
+
+#define MAG_CAL_Q 12                  // S fixed-point fraction bits (4096 = 1.0)
+#define MAG_CAL_MAX_DELTA 16383       // |m - b| clamp (2457 uT) keeps the row sum in 32 bits
+
+struct MagCalibration {
+  int16_t offset[3];
+  int16_t soft[3][3];                 // |entries| < 8.0
+};
+
+inline void applyMagCalibration(const MagCalibration &cal, const int16_t raw[3], int16_t out[3]) {
+  int32_t d[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    d[i] = (int32_t)raw[i] - cal.offset[i];
+    if (d[i] > MAG_CAL_MAX_DELTA) d[i] = MAG_CAL_MAX_DELTA;
+    if (d[i] < -MAG_CAL_MAX_DELTA) d[i] = -MAG_CAL_MAX_DELTA;
+  }
+  for (uint8_t row = 0; row < 3; row++) {
+    int32_t sum = 1L << (MAG_CAL_Q - 1);  // Round to nearest
+    for (uint8_t col = 0; col < 3; col++) sum += (int32_t)cal.soft[row][col] * d[col];
+    sum >>= MAG_CAL_Q;
+    if (sum > 32767) sum = 32767;
+    if (sum < -32768) sum = -32768;
+    out[row] = (int16_t)sum;
+  }
+}
+
+#endif // IMU_MAG_H
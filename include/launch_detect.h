@@ -0,0 +1,69 @@
+/*
+ * IMU launch detector
+ * Runs on every raw FIFO sample (≥500 Hz) and latches launch once the
+ * acceleration magnitude has stayed above LAUNCH_ACCEL_THRESHOLD_G for
+ * LAUNCH_SUSTAIN_MS. Integer magnitude-squared only, no sqrt or floats in
+ * the per-sample path. Single-sample shocks (pad bumps, ejection charges
+ * on other stages) don't last long enough to latch.
+ *
+ * Header-only and free of Arduino dependencies so the same code runs in
+ * examples/launch_detect/launch_detect_test.cpp on the host.
+ */
+
+#ifndef LAUNCH_DETECT_H
+#define LAUNCH_DETECT_H
+
+#include <stdint.h>
+#include "config.h"
+
+#define LAUNCH_COUNTS_PER_G 2048      // Raw accel at ±16 g (initIMU() full scale)
+#define LAUNCH_THRESHOLD_COUNTS ((int32_t)(LAUNCH_ACCEL_THRESHOLD_G * LAUNCH_COUNTS_PER_G))
+#define LAUNCH_THRESHOLD_SQ ((uint32_t)(LAUNCH_THRESHOLD_COUNTS * LAUNCH_THRESHOLD_COUNTS))
+
+struct LaunchDetector {
+  unsigned long runStartUs;           // First sample of the current above-threshold run
+  uint16_t runSamples;
+  unsigned long launchUs;             // runStartUs of the run that latched
+  bool launched;
+};
+
+inline void resetLaunchDetector(LaunchDetector &det) {
+  det.runStartUs = 0;
+  det.runSamples = 0;
+  det.launchUs = 0;
+  det.launched = false;
+}
+
+// |a|^2 in counts^2: each square is at most 2^30, the sum fits in 32 bits
+inline uint32_t accelMagnitudeSq(const int16_t accel[3]) {
+  uint32_t sum = 0;
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    int32_t a = accel[axis];
+    sum += (uint32_t)(a * a);
+  }
+  return sum;
+}
+
+// Feed one sample (raw counts, its timestamp). Returns true on the sample
+// that latches launch; launchUs is then the start of the sustained run.
+inline bool launchDetectorUpdate(LaunchDetector &det, const int16_t accel[3], unsigned long sampleUs) {
+  if (det.launched) return false;
+
+  if (accelMagnitudeSq(accel) <= LAUNCH_THRESHOLD_SQ) {
+    det.runSamples = 0;
+    return false;
+  }
+
+  if (det.runSamples == 0) det.runStartUs = sampleUs;
+  if (det.runSamples < 0xFFFF) det.runSamples++;
+
+  if (det.runSamples >= LAUNCH_SUSTAIN_MIN_SAMPLES &&
+      sampleUs - det.runStartUs >= LAUNCH_SUSTAIN_MS * 1000UL) {
+    det.launched = true;
+    det.launchUs = det.runStartUs;
+    return true;
+  }
+  return false;
+}
+
+#endif // LAUNCH_DETECT_H
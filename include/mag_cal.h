@@ -0,0 +1,9 @@
+// Magnetometer hard/soft-iron calibration, generated by tools/mag_calibrate.py
+// Identity until a calibration has been run: offset 0, soft-iron 1.0 (Q12)
+#ifndef MAG_CAL_H
+#define MAG_CAL_H
+
+#define MAG_CAL_OFFSET { 0, 0, 0 }
+#define MAG_CAL_SOFT { { 4096, 0, 0 }, { 0, 4096, 0 }, { 0, 0, 4096 } }
+
+#endif // MAG_CAL_H
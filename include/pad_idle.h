@@ -0,0 +1,19 @@
+#ifndef PAD_IDLE_H
+#define PAD_IDLE_H
+
+#include <Arduino.h>
+
+// Low-power pad wait: the IMU sits in wake-on-motion, the baro takes a
+// forced conversion every BARO_IDLE_TICK_MS and the MCU idle-sleeps in
+// between. Motion (INT1) wakes the MCU at once and updatePadIdle() puts
+// the IMU and baro back at flight rate before the next sample is due.
+// Both are loop()'s to call: updatePadIdle() at the top of the pass,
+// padIdleSleep() at the end in place of its delay.
+
+bool enterPadIdle();
+void exitPadIdle();
+bool isPadIdle();
+bool updatePadIdle();     // Call every loop; true on the call that woke on motion
+void padIdleSleep();      // Sleep until the next baro tick or motion (blocks up to BARO_IDLE_TICK_MS)
+
+#endif // PAD_IDLE_H
@@ -13,9 +13,30 @@ struct DateTime {
   bool dataValid;
 };
 
+// Compact timestamp: Unix epoch seconds plus milliseconds. This is the
+// in-RAM and on-card form; civil formatting is left to tools/decode_log.py.
+struct Timestamp {
+  uint32_t epoch;
+  uint16_t ms;
+};
+
+// Aging-offset correction mode (PCF8523 Offset register bit 7)
+enum RTCOffsetMode {
+  RTC_OFFSET_TWO_HOURS = 0x00,   // 4.340 ppm/LSB, applied every two hours
+  RTC_OFFSET_ONE_MINUTE = 0x80   // 4.069 ppm/LSB, applied every minute
+};
+
 bool initRTC();
 bool readRTC(DateTime &dt);
 bool setRTC(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second);
+bool enableRTCSecondTick();  // 1 Hz active-low pulse on INT1
+bool calibrateRTC(RTCOffsetMode mode, int8_t offset);  // offset -64..63, +ve speeds up
+int8_t readRTCOffset();
+
+// Unix epoch seconds <-> civil date (valid 2000-2099)
+uint32_t dateTimeToEpoch(const DateTime &dt);
+void epochToDateTime(uint32_t epoch, DateTime &dt);
+int32_t timestampDiffMs(const Timestamp &from, const Timestamp &to);
 
 #endif
 
@@ -0,0 +1,104 @@
+/*
+ * Flight sequencer states
+ * The state and phase enums, the handlers each state runs (defined in
+ * sequencer.cpp) and the PROGMEM table that wires them together
+ * (src/sequencer_states.cpp). Free of Arduino dependencies so the table
+ * can be checked on the host against stub handlers.
+ */
+
+#ifndef SEQUENCER_STATES_H
+#define SEQUENCER_STATES_H
+
+#include "sequencer_table.h"
+
+// Sequencer State Definitions
+enum SequencerState {
+  // SBIT - Startup Sequence (0-5)
+  SBIT_INIT_SEQ_IMU = 0,        // Initialize sequencer & IMU
+  SBIT_STARTUP_BATTERY = 1,     // Check startup battery
+  SBIT_STARTUP_TELEM = 2,       // Startup telemetry (sensors)
+  SBIT_STARTUP_PAYLOAD = 3,     // Startup payload battery
+  SBIT_PAYLOAD_TELEM = 4,       // Startup payload telemetry
+  SBIT_RBSAFE_CHECK = 5,        // Check RBSAFE validation
+
+  // LBIT - Launch Sequence (6-9)
+  LBIT_IGNIT_BOOSTER = 6,       // Ignit booster
+  LBIT_LAUNCH = 7,              // Launch!!!
+  LBIT_POST_LAUNCH_REPORT = 8,  // Post-launch report bit (reports apogee)
+  LBIT_APOGEE_REPORT = 9,       // Reports apogee via mag alt pages
+
+  // DBIT - Deploy Sequence (10-15)
+  DBIT_POP_NOSE_FAIRING = 10,   // Pop nose fairing
+  DBIT_STAGE_SEPARATION = 11,   // First stage separation
+  DBIT_BOOM_PAYLOAD = 12,       // Boom payload from booster
+  DBIT_FINAL_MODE = 13,         // Final mode (post deploy)
+  DBIT_DEPLOY_PARACHUTE = 14,   // From deploy parachute
+  DBIT_SEND_ALL_TELEM = 15,     // Send all recorded telemetry
+
+  // ABIT - Abort Sequence (16)
+  ABIT_KILL_ALL_PROCESSES = 16  // Kills all processes & shuts down
+};
+
+#define SEQ_STATE_COUNT 17
+#define SEQ_MAX_RETRIES 3         // SBIT timeouts retried before aborting
+
+// Mission Phase tracking for higher-level state management
+enum MissionPhase {
+  PHASE_STARTUP,
+  PHASE_PREFLIGHT,
+  PHASE_LAUNCH,
+  PHASE_FLIGHT,
+  PHASE_DEPLOY,
+  PHASE_RECOVERY,
+  PHASE_ABORT
+};
+
+#define SEQ_PHASE_COUNT 7
+
+// State handlers (sequencer.cpp)
+bool sbitSensorsChecked();
+void sbitCheckBattery();
+bool sbitBatteryOK();
+bool sbitSensorsOK();
+void sbitPayloadPower();
+bool sbitPayloadOK();
+bool sbitPayloadTelemOK();
+bool sbitAllOK();
+void lbitPadWait();
+void lbitPadService();
+bool lbitLaunched();
+void lbitLaunch();
+bool lbitClearOfPad();
+void lbitTrackAscent();
+bool lbitApogee();
+void lbitApogeeReport();
+void dbitPopFairing();
+void dbitSeparateStage();
+void dbitDeployPayload();
+void dbitDeployParachute();
+void dbitRecoveryTelemetry();
+bool dbitLanded();
+void abitShutdown();
+
+inline bool seqAlways() { return true; }
+
+// Loop services (sequencer.cpp, hardware_control.cpp, flight_detection.cpp)
+void servicePadWake();
+uint8_t servicePyroOutputs();
+void serviceLaunchDetector();
+
+// Every loop() pass, ahead of updateSequencer(): motion ends pad idle,
+// pyro pulses end on time and the IMU FIFO is drained into the launch
+// detector, the only thing that latches lbitLaunched(). True while a pyro
+// pulse is still running, so loop() doesn't sleep through its deadline.
+inline bool serviceSequencerInputs() {
+  servicePadWake();
+  bool pulsing = servicePyroOutputs() > 0;
+  serviceLaunchDetector();
+  return pulsing;
+}
+
+extern const SeqStateDef sequencerStates[SEQ_STATE_COUNT] PROGMEM;
+extern const char *const missionPhaseNames[SEQ_PHASE_COUNT] PROGMEM;
+
+#endif // SEQUENCER_STATES_H
@@ -0,0 +1,133 @@
+/*
+ * Table-driven state machine
+ * Each state is one SeqStateDef row in flash: entry, tick and exit
+ * handlers, a guard that moves to `next`, and an optional timeout that
+ * moves to `timeoutNext` (or retries the state when that is the state
+ * itself). seqTick() indexes the current row directly, copies it out of
+ * flash and runs it; a transition runs the old row's exit and the new
+ * row's entry on the same tick.
+ *
+ * Header-only and free of Arduino dependencies so the same interpreter
+ * and the flight table (src/sequencer_states.cpp) run in
+ * examples/sequencer_table/sequencer_table_test.cpp on the host.
+ */
+
+#ifndef SEQUENCER_TABLE_H
+#define SEQUENCER_TABLE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#elif !defined(PROGMEM)
+#define PROGMEM
+#define memcpy_P memcpy
+#endif
+
+#define SEQ_NONE 0xFF     // No transition / phase unchanged
+
+typedef void (*SeqAction)();
+typedef bool (*SeqGuard)();
+
+struct SeqStateDef {
+  const char *name;       // Flash string
+  SeqAction entry;        // Once on the way in (NULL = none)
+  SeqAction tick;         // Every tick while in the state
+  SeqAction exit;         // Once on the way out
+  SeqGuard guard;         // True moves to next (NULL = never)
+  uint8_t next;
+  uint8_t phase;          // Phase entered with this state (SEQ_NONE = unchanged)
+  uint16_t timeoutMs;     // 0 = no timeout
+  uint8_t timeoutNext;    // Self = retry (entry again), up to maxRetries
+};
+
+struct SeqMachine;
+typedef void (*SeqTransitionHook)(const SeqMachine &m, uint8_t from, uint8_t fromPhase);
+
+struct SeqMachine {
+  const SeqStateDef *table;   // In flash
+  uint8_t count;
+  uint8_t state;
+  uint8_t phase;
+  uint8_t retries;
+  uint8_t maxRetries;
+  unsigned long stateStartMs;
+  SeqTransitionHook onTransition;   // Before the new state's entry (logging)
+};
+
+enum SeqResult {
+  SEQ_STAY,
+  SEQ_MOVED,
+  SEQ_RETRY,              // Timed out, state entered again
+  SEQ_EXHAUSTED           // Timed out with no retries left, caller decides
+};
+
+inline void seqReadState(const SeqMachine &m, uint8_t state, SeqStateDef &row) {
+  memcpy_P(&row, &m.table[state], sizeof(row));
+}
+
+// Flash pointer to the state's name (print with F()-style helpers on AVR)
+inline const char *seqStateName(const SeqMachine &m, uint8_t state) {
+  const char *name = 0;
+  if (state < m.count) memcpy_P(&name, &m.table[state].name, sizeof(name));
+  return name;
+}
+
+inline void seqTransition(SeqMachine &m, uint8_t to, unsigned long nowMs) {
+  SeqStateDef row;
+  seqReadState(m, m.state, row);
+  if (row.exit) row.exit();
+
+  uint8_t from = m.state;
+  uint8_t fromPhase = m.phase;
+  seqReadState(m, to, row);
+  m.state = to;
+  m.stateStartMs = nowMs;
+  m.retries = 0;
+  if (row.phase != SEQ_NONE) m.phase = row.phase;
+  if (m.onTransition) m.onTransition(m, from, fromPhase);
+  if (row.entry) row.entry();
+}
+
+// Starts the machine in `state` without an exit or transition hook
+inline void seqStart(SeqMachine &m, const SeqStateDef *table, uint8_t count, uint8_t state,
+                     uint8_t phase, uint8_t maxRetries, unsigned long nowMs) {
+  m.table = table;
+  m.count = count;
+  m.state = state;
+  m.phase = phase;
+  m.retries = 0;
+  m.maxRetries = maxRetries;
+  m.stateStartMs = nowMs;
+
+  SeqStateDef row;
+  seqReadState(m, state, row);
+  if (row.phase != SEQ_NONE) m.phase = row.phase;
+  if (row.entry) row.entry();
+}
+
+inline SeqResult seqTick(SeqMachine &m, unsigned long nowMs) {
+  SeqStateDef row;
+  seqReadState(m, m.state, row);
+  if (row.tick) row.tick();
+
+  if (row.guard && row.guard()) {
+    seqTransition(m, row.next, nowMs);
+    return SEQ_MOVED;
+  }
+  if (row.timeoutMs == 0 || nowMs - m.stateStartMs < row.timeoutMs) return SEQ_STAY;
+
+  if (row.timeoutNext != m.state) {
+    seqTransition(m, row.timeoutNext, nowMs);
+    return SEQ_MOVED;
+  }
+  if (m.retries >= m.maxRetries) return SEQ_EXHAUSTED;
+  m.retries++;
+  m.stateStartMs = nowMs;
+  if (row.exit) row.exit();
+  if (row.entry) row.entry();
+  return SEQ_RETRY;
+}
+
+#endif // SEQUENCER_TABLE_H
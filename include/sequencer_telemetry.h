@@ -0,0 +1,175 @@
+/*
+ * Sequencer telemetry record
+ * formatTelemetryRecord() writes one CSV record straight into a caller
+ * buffer: no String, no heap, state and phase names read from flash.
+ * Floats are printed the way Print does (2 decimals, 6 for lat/lon), so
+ * the columns match the old String-built records.
+ *
+ * Header-only and free of Arduino dependencies so the same code runs in
+ * examples/sequencer_telemetry/sequencer_telemetry_test.cpp on the host.
+ */
+
+#ifndef SEQUENCER_TELEMETRY_H
+#define SEQUENCER_TELEMETRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include "sequencer_states.h"
+
+#ifndef pgm_read_byte
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#endif
+
+#define TELEMETRY_RECORD_MAX 256      // Fits 5-digit readings in every field; typical is ~130
+
+// Enhanced telemetry data structure
+struct SequencerTelemetryData {
+  unsigned long timestamp;
+  SequencerState sequencerState;
+  MissionPhase missionPhase;
+  float temperature;
+  float pressure;
+  float altitude;
+  float altitudeAGL;  // Above Ground Level
+  float gps_lat;
+  float gps_lon;
+  float gps_alt;
+  int gps_satellites;
+  float accel_x, accel_y, accel_z;
+  float gyro_x, gyro_y, gyro_z;
+  float accel_magnitude;
+  float vertical_velocity;
+  bool batteryOK;
+  bool sensorsOK;
+  bool payloadOK;
+};
+
+// Bounded append into a caller buffer; overflow sticks and truncates
+struct RecordWriter {
+  char *buf;
+  size_t size;
+  size_t len;
+  bool overflow;
+};
+
+inline void recordPutChar(RecordWriter &w, char c) {
+  if (w.len + 1 < w.size) {
+    w.buf[w.len++] = c;
+    w.buf[w.len] = '\0';
+  } else {
+    w.overflow = true;
+  }
+}
+
+inline void recordPutStr(RecordWriter &w, const char *s) {
+  while (*s) recordPutChar(w, *s++);
+}
+
+inline void recordPutStrP(RecordWriter &w, const char *flash) {
+  for (char c = pgm_read_byte(flash); c; c = pgm_read_byte(++flash)) recordPutChar(w, c);
+}
+
+inline void recordPutUInt(RecordWriter &w, unsigned long v) {
+  char digits[10];
+  uint8_t n = 0;
+  do {
+    digits[n++] = '0' + v % 10;
+    v /= 10;
+  } while (v);
+  while (n) recordPutChar(w, digits[--n]);
+}
+
+inline void recordPutInt(RecordWriter &w, long v) {
+  if (v < 0) {
+    recordPutChar(w, '-');
+    recordPutUInt(w, 0UL - (unsigned long)v);
+  } else {
+    recordPutUInt(w, (unsigned long)v);
+  }
+}
+
+// Same algorithm as Print::printFloat
+inline void recordPutFloat(RecordWriter &w, double number, uint8_t digits) {
+  if (isnan(number)) {
+    recordPutStr(w, "nan");
+    return;
+  }
+  if (isinf(number)) {
+    recordPutStr(w, "inf");
+    return;
+  }
+  if (number > 4294967040.0 || number < -4294967040.0) {
+    recordPutStr(w, "ovf");
+    return;
+  }
+  if (number < 0.0) {
+    recordPutChar(w, '-');
+    number = -number;
+  }
+
+  double rounding = 0.5;
+  for (uint8_t i = 0; i < digits; i++) rounding /= 10.0;
+  number += rounding;
+
+  unsigned long intPart = (unsigned long)number;
+  double remainder = number - (double)intPart;
+  recordPutUInt(w, intPart);
+  if (digits > 0) recordPutChar(w, '.');
+  while (digits-- > 0) {
+    remainder *= 10.0;
+    unsigned int digit = (unsigned int)remainder;
+    recordPutChar(w, '0' + digit);
+    remainder -= digit;
+  }
+}
+
+inline void recordPutField(RecordWriter &w, double v, uint8_t digits = 2) {
+  recordPutChar(w, ',');
+  recordPutFloat(w, v, digits);
+}
+
+// Timestamp,SeqState,SeqStateName,Phase,PhaseName,Temp_C,Pressure_Pa,
+// Altitude_m,AltitudeAGL_m,VerticalVel_ms,Lat,Lon,GPS_Alt_m,Satellites,
+// Accel_X,Accel_Y,Accel_Z,AccelMag,Gyro_X,Gyro_Y,Gyro_Z,Battery,Sensors,Payload
+// Returns the length, or 0 if the record didn't fit (buf holds a prefix)
+inline size_t formatTelemetryRecord(char *buf, size_t size, const SequencerTelemetryData &d,
+                                    const char *stateName, const char *phaseName) {
+  if (size == 0) return 0;
+  RecordWriter w = {buf, size, 0, false};
+  buf[0] = '\0';
+
+  recordPutUInt(w, d.timestamp);
+  recordPutChar(w, ',');
+  recordPutInt(w, (int)d.sequencerState);
+  recordPutChar(w, ',');
+  recordPutStrP(w, stateName);
+  recordPutChar(w, ',');
+  recordPutInt(w, (int)d.missionPhase);
+  recordPutChar(w, ',');
+  recordPutStrP(w, phaseName);
+  recordPutField(w, d.temperature);
+  recordPutField(w, d.pressure);
+  recordPutField(w, d.altitude);
+  recordPutField(w, d.altitudeAGL);
+  recordPutField(w, d.vertical_velocity);
+  recordPutField(w, d.gps_lat, 6);
+  recordPutField(w, d.gps_lon, 6);
+  recordPutField(w, d.gps_alt);
+  recordPutChar(w, ',');
+  recordPutInt(w, d.gps_satellites);
+  recordPutField(w, d.accel_x);
+  recordPutField(w, d.accel_y);
+  recordPutField(w, d.accel_z);
+  recordPutField(w, d.accel_magnitude);
+  recordPutField(w, d.gyro_x);
+  recordPutField(w, d.gyro_y);
+  recordPutField(w, d.gyro_z);
+  recordPutStr(w, d.batteryOK ? ",OK" : ",LOW");
+  recordPutStr(w, d.sensorsOK ? ",OK" : ",FAIL");
+  recordPutStr(w, d.payloadOK ? ",OK" : ",FAIL");
+
+  return w.overflow ? 0 : w.len;
+}
+
+#endif // SEQUENCER_TELEMETRY_H
@@ -0,0 +1,19 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <Arduino.h>
+#include "rtc_pcf8523.h"
+
+// Wall-clock timebase: the PCF8523 is read once at boot (on a seconds edge)
+// and anchored to millis(); timestamps are derived locally after that and
+// re-synced against the RTC every TIMEBASE_RESYNC_MS.
+// With TIMEBASE_USE_RTC_TICK the RTC's 1 Hz INT1 pulse re-anchors micros()
+// every second and measures the resonator drift, with no extra I2C polling.
+
+bool initTimebase();
+void updateTimebase();                // Call every loop; does the periodic re-sync
+bool getTimestamp(Timestamp &ts);     // Monotonic, ms resolution; uptime if not anchored
+bool isTimebaseValid();
+float getTimebaseDriftPpm();          // Resonator error vs RTC, 0 without the tick
+
+#endif // TIMEBASE_H
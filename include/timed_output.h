@@ -0,0 +1,88 @@
+/*
+ * Timed outputs
+ * A pulse drives a pin high now and records when it has to drop;
+ * timedOutputService() lowers every pin whose deadline has passed. Called
+ * every loop pass, so pyro pulses end on time while sampling, logging and
+ * the sequencer keep running instead of sitting in delay().
+ *
+ * Header-only and free of Arduino dependencies so the same code runs in
+ * examples/timed_output/timed_output_test.cpp on the host.
+ */
+
+#ifndef TIMED_OUTPUT_H
+#define TIMED_OUTPUT_H
+
+#include <stdint.h>
+
+#define TIMED_OUTPUT_SLOTS 5          // One per pyro channel
+
+typedef void (*OutputWrite)(uint8_t pin, uint8_t level);   // digitalWrite on the board
+
+struct TimedOutput {
+  uint8_t pin;
+  bool active;
+  unsigned long startMs;
+  unsigned long durationMs;
+};
+
+struct TimedOutputs {
+  OutputWrite write;
+  TimedOutput slot[TIMED_OUTPUT_SLOTS];
+};
+
+inline void initTimedOutputs(TimedOutputs &outs, OutputWrite write) {
+  outs.write = write;
+  for (uint8_t i = 0; i < TIMED_OUTPUT_SLOTS; i++) outs.slot[i].active = false;
+}
+
+// Pin high for durationMs from nowMs. A pin already pulsing keeps its
+// original deadline. False (pin untouched) when every slot is busy.
+inline bool timedOutputPulse(TimedOutputs &outs, uint8_t pin, unsigned long durationMs,
+                             unsigned long nowMs) {
+  TimedOutput *idle = 0;
+  for (uint8_t i = 0; i < TIMED_OUTPUT_SLOTS; i++) {
+    TimedOutput &out = outs.slot[i];
+    if (out.active && out.pin == pin) return true;
+    if (!out.active && !idle) idle = &out;
+  }
+  if (!idle) return false;
+
+  idle->pin = pin;
+  idle->startMs = nowMs;
+  idle->durationMs = durationMs;
+  idle->active = true;
+  outs.write(pin, 1);
+  return true;
+}
+
+// Lowers expired pulses; returns how many are still running
+inline uint8_t timedOutputService(TimedOutputs &outs, unsigned long nowMs) {
+  uint8_t running = 0;
+  for (uint8_t i = 0; i < TIMED_OUTPUT_SLOTS; i++) {
+    TimedOutput &out = outs.slot[i];
+    if (!out.active) continue;
+    if (nowMs - out.startMs >= out.durationMs) {
+      outs.write(out.pin, 0);
+      out.active = false;
+    } else {
+      running++;
+    }
+  }
+  return running;
+}
+
+// Drops every pulse now (safing)
+inline void timedOutputCancelAll(TimedOutputs &outs) {
+  for (uint8_t i = 0; i < TIMED_OUTPUT_SLOTS; i++) {
+    TimedOutput &out = outs.slot[i];
+    if (out.active) outs.write(out.pin, 0);
+    out.active = false;
+  }
+}
+
+// Pyro channels (hardware_control.cpp): igniteBooster() etc. start a
+// PYRO_PULSE_MS pulse and return at once; call this every loop pass.
+// Returns the pulses still running.
+uint8_t servicePyroOutputs();
+
+#endif // TIMED_OUTPUT_H
@@ -3,12 +3,15 @@
 
 #include "rtc_pcf8523.h"
 #include "baro_bmp280.h"
+#include "imu_icm20948.h"
 
 bool initSD();
 bool startLogging(const char* fileName);
 bool stopLogging();
-bool writeData(const DateTime& dt, const BaroData& data);
-bool writeData(const DateTime& dt, const char* event, const char* message);
+bool writeData(const Timestamp& ts, const BaroData& data);
+bool writeData(const Timestamp& ts, const char* event, const char* message);
+bool writeData(const Timestamp& ts, const IMURawData& imu);
+bool writeRecord(const Timestamp& ts, const char* tag, const char* fields);
 bool deleteFile(const char* fileName);
 bool isLoggingActive();
 const char* getCurrentFileName();
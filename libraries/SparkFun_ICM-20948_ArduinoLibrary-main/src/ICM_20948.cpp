@@ -15,6 +15,7 @@ ICM_20948::ICM_20948()
   status = ICM_20948_init_struct(&_device);
 }
 
+#if !defined(ICM_20948_SLIM)
 void ICM_20948::enableDebugging(Stream &debugPort)
 {
   _debugSerial = &debugPort; //Grab which port the user wants us to use for debugging
@@ -138,6 +139,8 @@ void ICM_20948::debugPrintStatus(ICM_20948_Status_e stat)
   }
 }
 
+#endif // ICM_20948_SLIM
+
 ICM_20948_AGMT_t ICM_20948::getAGMT(void)
 {
   status = ICM_20948_get_agmt(&_device, &agmt);
@@ -239,6 +242,7 @@ float ICM_20948::getGyrDPS(int16_t axis_val)
   }
 }
 
+#if !defined(ICM_20948_SLIM)
 //Gyro Bias
 ICM_20948_Status_e ICM_20948::setBiasGyroX( int32_t newValue)
 {
@@ -528,6 +532,8 @@ ICM_20948_Status_e ICM_20948::getBiasCPassZ( int32_t* bias)
   return ICM_20948_Stat_DMPNotSupported;
 }
 
+#endif // ICM_20948_SLIM
+
 float ICM_20948::temp(void)
 {
   return getTempC(agmt.tmp.val);
@@ -538,6 +544,7 @@ float ICM_20948::getTempC(int16_t val)
   return (((float)val - 21) / 333.87) + 21;
 }
 
+#if !defined(ICM_20948_SLIM)
 const char *ICM_20948::statusString(ICM_20948_Status_e stat)
 {
   ICM_20948_Status_e val;
@@ -607,6 +614,8 @@ const char *ICM_20948::statusString(ICM_20948_Status_e stat)
   return "None";
 }
 
+#endif // ICM_20948_SLIM
+
 // Device Level
 ICM_20948_Status_e ICM_20948::setBank(uint8_t bank)
 {
@@ -1259,6 +1268,22 @@ ICM_20948_Status_e ICM_20948::write(uint8_t reg, uint8_t *pdata, uint32_t len)
   return (status);
 }
 
+uint32_t ICM_20948::getTransactionCount(void)
+{
+  return _device._txn_count;
+}
+
+uint32_t ICM_20948::getTransactionBytes(void)
+{
+  return _device._txn_bytes;
+}
+
+void ICM_20948::resetTransactionCount(void)
+{
+  _device._txn_count = 0;
+  _device._txn_bytes = 0;
+}
+
 uint8_t ICM_20948::readMag(AK09916_Reg_Addr_e reg)
 {
   uint8_t data = i2cMasterSingleR(MAG_AK09916_I2C_ADDR, reg); // i2cMasterSingleR updates status too
@@ -1315,6 +1340,7 @@ ICM_20948_Status_e ICM_20948::readFIFO(uint8_t *data, uint8_t len)
   return status;
 }
 
+#if !defined(ICM_20948_SLIM)
 // DMP
 
 ICM_20948_Status_e ICM_20948::enableDMP(bool enable)
@@ -1703,6 +1729,8 @@ ICM_20948_Status_e ICM_20948::initializeDMP(void)
   return worstResult;
 }
 
+#endif // ICM_20948_SLIM
+
 // I2C
 ICM_20948_I2C::ICM_20948_I2C()
 {
@@ -1752,6 +1780,7 @@ ICM_20948_Status_e ICM_20948_I2C::begin(TwoWire &wirePort, bool ad0val, uint8_t
   _device._firmware_loaded = false; // Initialize _firmware_loaded
   _device._last_bank = 255;         // Initialize _last_bank. Make it invalid. It will be set by the first call of ICM_20948_set_bank.
   _device._last_mems_bank = 255;    // Initialize _last_mems_bank. Make it invalid. It will be set by the first call of inv_icm20948_write_mems.
+  _device._fss_cached = false;      // Full-scale settings are read from the chip on the first getAGMT
   _device._gyroSF = 0;              // Use this to record the GyroSF, calculated by inv_icm20948_set_gyro_sf
   _device._gyroSFpll = 0;
   _device._enabled_Android_0 = 0;      // Keep track of which Android sensors are enabled: 0-31
@@ -1907,6 +1936,27 @@ ICM_20948_Status_e ICM_20948::magWhoIAm(void)
 
 ICM_20948_SPI::ICM_20948_SPI()
 {
+  _batch = false;
+}
+
+void ICM_20948_SPI::beginBatch(void)
+{
+  if (_batch)
+    return;
+
+  // One kickstart for the whole batch (see ICM_20948_write_SPI)
+  _spi->beginTransaction(_spisettings);
+  _spi->transfer(0x00);
+  _batch = true;
+}
+
+void ICM_20948_SPI::endBatch(void)
+{
+  if (!_batch)
+    return;
+
+  _spi->endTransaction();
+  _batch = false;
 }
 
 ICM_20948_Status_e ICM_20948_SPI::begin(uint8_t csPin, SPIClass &spiPort, uint32_t SPIFreq)
@@ -1949,6 +1999,7 @@ ICM_20948_Status_e ICM_20948_SPI::begin(uint8_t csPin, SPIClass &spiPort, uint32
   _device._firmware_loaded = false; // Initialize _firmware_loaded
   _device._last_bank = 255;         // Initialize _last_bank. Make it invalid. It will be set by the first call of ICM_20948_set_bank.
   _device._last_mems_bank = 255;    // Initialize _last_mems_bank. Make it invalid. It will be set by the first call of inv_icm20948_write_mems.
+  _device._fss_cached = false;      // Full-scale settings are read from the chip on the first getAGMT
   _device._gyroSF = 0;              // Use this to record the GyroSF, calculated by inv_icm20948_set_gyro_sf
   _device._gyroSFpll = 0;
   _device._enabled_Android_0 = 0;      // Keep track of which Android sensors are enabled: 0-31
@@ -2048,18 +2099,22 @@ ICM_20948_Status_e ICM_20948_write_SPI(uint8_t reg, uint8_t *data, uint32_t len,
   }
   SPIClass *_spi = ((ICM_20948_SPI *)user)->_spi; // Cast user field to ICM_20948_SPI type and extract the SPI interface pointer
   uint8_t cs = ((ICM_20948_SPI *)user)->_cs;
-  SPISettings spisettings = ((ICM_20948_SPI *)user)->_spisettings;
+  bool batch = ((ICM_20948_SPI *)user)->_batch;
   if (_spi == NULL)
   {
     return ICM_20948_Stat_ParamErr;
   }
 
-  // 'Kickstart' the SPI hardware. This is a fairly high amount of overhead, but it guarantees that the lines will start in the correct states even when sharing the SPI bus with devices that use other modes
-  _spi->beginTransaction(spisettings);
-  _spi->transfer(0x00);
-  _spi->endTransaction();
+  if (!batch) // beginBatch has already done this
+  {
+    // 'Kickstart' the SPI hardware. This is a fairly high amount of overhead, but it guarantees that the lines will start in the correct states even when sharing the SPI bus with devices that use other modes
+    SPISettings spisettings = ((ICM_20948_SPI *)user)->_spisettings;
+    _spi->beginTransaction(spisettings);
+    _spi->transfer(0x00);
+    _spi->endTransaction();
 
-  _spi->beginTransaction(spisettings);
+    _spi->beginTransaction(spisettings);
+  }
   digitalWrite(cs, LOW);
   // delayMicroseconds(5);
   _spi->transfer(((reg & 0x7F) | 0x00));
@@ -2070,7 +2125,8 @@ ICM_20948_Status_e ICM_20948_write_SPI(uint8_t reg, uint8_t *data, uint32_t len,
   }
   // delayMicroseconds(5);
   digitalWrite(cs, HIGH);
-  _spi->endTransaction();
+  if (!batch)
+    _spi->endTransaction();
 
   return ICM_20948_Stat_Ok;
 }
@@ -2083,29 +2139,32 @@ ICM_20948_Status_e ICM_20948_read_SPI(uint8_t reg, uint8_t *buff, uint32_t len,
   }
   SPIClass *_spi = ((ICM_20948_SPI *)user)->_spi;
   uint8_t cs = ((ICM_20948_SPI *)user)->_cs;
-  SPISettings spisettings = ((ICM_20948_SPI *)user)->_spisettings;
+  bool batch = ((ICM_20948_SPI *)user)->_batch;
   if (_spi == NULL)
   {
     return ICM_20948_Stat_ParamErr;
   }
 
-  // 'Kickstart' the SPI hardware. This is a fairly high amount of overhead, but it guarantees that the lines will start in the correct states
-  _spi->beginTransaction(spisettings);
-  _spi->transfer(0x00);
-  _spi->endTransaction();
+  if (!batch) // beginBatch has already done this
+  {
+    // 'Kickstart' the SPI hardware. This is a fairly high amount of overhead, but it guarantees that the lines will start in the correct states
+    SPISettings spisettings = ((ICM_20948_SPI *)user)->_spisettings;
+    _spi->beginTransaction(spisettings);
+    _spi->transfer(0x00);
+    _spi->endTransaction();
 
-  _spi->beginTransaction(spisettings);
+    _spi->beginTransaction(spisettings);
+  }
   digitalWrite(cs, LOW);
   //   delayMicroseconds(5);
   _spi->transfer(((reg & 0x7F) | 0x80));
-  //  SPI.transfer(data, len); // Can't do this thanks to Arduino's stupid implementation
-  for (uint32_t indi = 0; indi < len; indi++)
-  {
-    *(buff + indi) = _spi->transfer(0x00);
-  }
+  // Reading, so the buffer can be clocked out in place: zero it and use the block transfer
+  memset(buff, 0x00, len);
+  _spi->transfer(buff, len);
   //   delayMicroseconds(5);
   digitalWrite(cs, HIGH);
-  _spi->endTransaction();
+  if (!batch)
+    _spi->endTransaction();
 
   return ICM_20948_Stat_Ok;
 }
@@ -20,8 +20,10 @@ A C++ interface to the ICM-20948
 class ICM_20948
 {
 private:
+#if !defined(ICM_20948_SLIM)
   Stream *_debugSerial;     //The stream to send debug messages to if enabled
   bool _printDebug = false; //Flag to print the serial commands we are sending to the Serial port for debug
+#endif
 
   const uint8_t MAX_MAGNETOMETER_STARTS = 10; // This replaces maxTries
 
@@ -36,6 +38,19 @@ protected:
 public:
   ICM_20948(); // Constructor
 
+#if defined(ICM_20948_SLIM)
+  // Debug printing compiles to nothing: the F() strings at the call sites are dropped with it
+  void enableDebugging(void) {}
+  void enableDebugging(Stream &) {}
+  void disableDebugging(void) {}
+  void debugPrintStatus(ICM_20948_Status_e) {}
+  void debugPrint(const char *) {}
+  void debugPrint(const __FlashStringHelper *) {}
+  void debugPrintln(const char *) {}
+  void debugPrintln(const __FlashStringHelper *) {}
+  void debugPrintf(int) {}
+  void debugPrintf(float) {}
+#else
 // Enable debug messages using the chosen Serial port (Stream)
 // Boards like the RedBoard Turbo use SerialUSB (not Serial).
 // But other boards like the SAMD51 Thing Plus use Serial (not SerialUSB).
@@ -71,6 +86,7 @@ public:
 
   void debugPrintf(int i);
   void debugPrintf(float f);
+#endif
 
   ICM_20948_AGMT_t agmt;          // Acceleometer, Gyroscope, Magenetometer, and Temperature data
   ICM_20948_AGMT_t getAGMT(void); // Updates the agmt field in the object and also returns a copy directly
@@ -90,7 +106,9 @@ public:
   float temp(void); // degrees celsius
 
   ICM_20948_Status_e status;                                              // Status from latest operation
+#if !defined(ICM_20948_SLIM) // The messages are RAM strings on AVR
   const char *statusString(ICM_20948_Status_e stat = ICM_20948_Stat_NUM); // Returns a human-readable status message. Defaults to status member, but prints string for supplied status if supplied
+#endif
 
   // Device Level
   ICM_20948_Status_e setBank(uint8_t bank);                                // Sets the bank
@@ -158,6 +176,11 @@ public:
   ICM_20948_Status_e read(uint8_t reg, uint8_t *pdata, uint32_t len);
   ICM_20948_Status_e write(uint8_t reg, uint8_t *pdata, uint32_t len);
 
+  // Bus accounting: serial interface transactions and bytes (incl. register address) since the last reset
+  uint32_t getTransactionCount(void);
+  uint32_t getTransactionBytes(void);
+  void resetTransactionCount(void);
+
   //Mag specific
   ICM_20948_Status_e startupMagnetometer(bool minimal = false); // If minimal is true, several startup steps are skipped. The mag then needs to be set up manually for the DMP.
   ICM_20948_Status_e magWhoIAm(void);
@@ -173,6 +196,7 @@ public:
   ICM_20948_Status_e readFIFO(uint8_t *data, uint8_t len = 1);
 
   //DMP
+#if !defined(ICM_20948_SLIM)
 
   //Gyro Bias
   ICM_20948_Status_e setBiasGyroX(int32_t newValue);
@@ -236,6 +260,7 @@ public:
   ICM_20948_Status_e readDMPdataFromFIFO(icm_20948_DMP_data_t *data);
   ICM_20948_Status_e setGyroSF(unsigned char div, int gyro_level);
   ICM_20948_Status_e initializeDMP(void) __attribute__((weak)); // Combine all of the DMP start-up code in one place. Can be overwritten if required
+#endif // ICM_20948_SLIM
 };
 
 // I2C
@@ -278,10 +303,16 @@ public:
   SPISettings _spisettings;
   uint8_t _cs;
   ICM_20948_Serif_t _serif;
+  bool _batch; // Inside beginBatch/endBatch: one SPI transaction, CS still toggled per register access
 
   ICM_20948_SPI(); // Constructor
 
   ICM_20948_Status_e begin(uint8_t csPin, SPIClass &spiPort = SPI, uint32_t SPIFreq = ICM_20948_SPI_DEFAULT_FREQ);
+
+  // Group several register accesses (e.g. getFIFOcount + readFIFO) under one beginTransaction/endTransaction,
+  // skipping the per-access 'kickstart' byte. Don't touch other devices on the bus until endBatch.
+  void beginBatch(void);
+  void endBatch(void);
 };
 
 #endif /* _ICM_20948_H_ */
@@ -22,6 +22,7 @@ const uint8_t dmp3_image[] = {
 };
 #endif
 
+#if !defined(ICM_20948_SLIM) // DMP byte ordering and Android sensor tables
 // ICM-20948 data is big-endian. We need to make it little-endian when writing into icm_20948_DMP_data_t
 const int DMP_Quat9_Byte_Ordering[icm_20948_DMP_Quat9_Bytes] =
     {
@@ -112,6 +113,7 @@ const uint16_t inv_androidSensor_to_control_bits[ANDROID_SENSOR_NUM_MAX] =
         0x8008, // 42 Raw Acc
         0x4048, // 43 Raw Gyr
 };
+#endif // ICM_20948_SLIM
 
 const ICM_20948_Serif_t NullSerif = {
     NULL, // write
@@ -152,6 +154,8 @@ ICM_20948_Status_e ICM_20948_execute_w(ICM_20948_Device_t *pdev, uint8_t regaddr
   {
     return ICM_20948_Stat_NotImpl;
   }
+  pdev->_txn_count++;
+  pdev->_txn_bytes += len + 1;
   return (*pdev->_serif->write)(regaddr, pdata, len, pdev->_serif->user);
 }
 
@@ -161,6 +165,8 @@ ICM_20948_Status_e ICM_20948_execute_r(ICM_20948_Device_t *pdev, uint8_t regaddr
   {
     return ICM_20948_Stat_NotImpl;
   }
+  pdev->_txn_count++;
+  pdev->_txn_bytes += len + 1;
   return (*pdev->_serif->read)(regaddr, pdata, len, pdev->_serif->user);
 }
 
@@ -273,9 +279,11 @@ ICM_20948_Status_e ICM_20948_set_bank(ICM_20948_Device_t *pdev, uint8_t bank)
   if (bank == pdev->_last_bank) // Do we need to change bank?
     return ICM_20948_Stat_Ok;   // Bail if we don't need to change bank to avoid unnecessary bus traffic
 
-  pdev->_last_bank = bank;   // Store the requested bank (before we bit-shift)
-  bank = (bank << 4) & 0x30; // bits 5:4 of REG_BANK_SEL
-  return ICM_20948_execute_w(pdev, REG_BANK_SEL, &bank, 1);
+  uint8_t sel = (bank << 4) & 0x30; // bits 5:4 of REG_BANK_SEL
+  ICM_20948_Status_e retval = ICM_20948_execute_w(pdev, REG_BANK_SEL, &sel, 1);
+  // Only trust the shadow once the write went through; after a failed write the chip's bank is unknown
+  pdev->_last_bank = (retval == ICM_20948_Stat_Ok) ? bank : 4;
+  return retval;
 }
 
 ICM_20948_Status_e ICM_20948_sw_reset(ICM_20948_Device_t *pdev)
@@ -298,6 +306,9 @@ ICM_20948_Status_e ICM_20948_sw_reset(ICM_20948_Device_t *pdev)
   {
     return retval;
   }
+  // The reset returns REG_BANK_SEL and the full-scale settings to their defaults
+  pdev->_last_bank = 0;
+  pdev->_fss_cached = false;
   return retval;
 }
 
@@ -704,6 +715,7 @@ ICM_20948_Status_e ICM_20948_set_full_scale(ICM_20948_Device_t *pdev, ICM_20948_
     // Check the data was written correctly
     retval |= ICM_20948_execute_r(pdev, AGB2_REG_ACCEL_CONFIG, (uint8_t *)&reg, sizeof(ICM_20948_ACCEL_CONFIG_t));
     if (reg.ACCEL_FS_SEL != fss.a) retval |= ICM_20948_Stat_Err;
+    pdev->_fss.a = reg.ACCEL_FS_SEL;
   }
   if (sensors & ICM_20948_Internal_Gyr)
   {
@@ -715,7 +727,13 @@ ICM_20948_Status_e ICM_20948_set_full_scale(ICM_20948_Device_t *pdev, ICM_20948_
     // Check the data was written correctly
     retval |= ICM_20948_execute_r(pdev, AGB2_REG_GYRO_CONFIG_1, (uint8_t *)&reg, sizeof(ICM_20948_GYRO_CONFIG_1_t));
     if (reg.GYRO_FS_SEL != fss.g) retval |= ICM_20948_Stat_Err;
+    pdev->_fss.g = reg.GYRO_FS_SEL;
   }
+  // The read-back values are only a complete cache if both sensors were set and verified
+  if (retval != ICM_20948_Stat_Ok)
+    pdev->_fss_cached = false;
+  else if ((sensors & ICM_20948_Internal_Acc) && (sensors & ICM_20948_Internal_Gyr))
+    pdev->_fss_cached = true;
   return retval;
 }
 
@@ -1084,17 +1102,22 @@ ICM_20948_Status_e ICM_20948_get_agmt(ICM_20948_Device_t *pdev, ICM_20948_AGMT_t
   pagmt->magStat2 = buff[22];
 
   // Get settings to be able to compute scaled values
-  retval |= ICM_20948_set_bank(pdev, 2);
-  ICM_20948_ACCEL_CONFIG_t acfg;
-  retval |= ICM_20948_execute_r(pdev, (uint8_t)AGB2_REG_ACCEL_CONFIG, (uint8_t *)&acfg, 1 * sizeof(acfg));
-  pagmt->fss.a = acfg.ACCEL_FS_SEL; // Worth noting that without explicitly setting the FS range of the accelerometer it was showing the register value for +/- 2g but the reported values were actually scaled to the +/- 16g range
-                                    // Wait a minute... now it seems like this problem actually comes from the digital low-pass filter. When enabled the value is 1/8 what it should be...
-  retval |= ICM_20948_set_bank(pdev, 2);
-  ICM_20948_GYRO_CONFIG_1_t gcfg1;
-  retval |= ICM_20948_execute_r(pdev, (uint8_t)AGB2_REG_GYRO_CONFIG_1, (uint8_t *)&gcfg1, 1 * sizeof(gcfg1));
-  pagmt->fss.g = gcfg1.GYRO_FS_SEL;
-  ICM_20948_ACCEL_CONFIG_2_t acfg2;
-  retval |= ICM_20948_execute_r(pdev, (uint8_t)AGB2_REG_ACCEL_CONFIG_2, (uint8_t *)&acfg2, 1 * sizeof(acfg2));
+  // The full-scale settings are static config: read them from bank 2 only when the cache is cold,
+  // so steady-state reads stay in bank 0 and cost a single transaction
+  if (!pdev->_fss_cached)
+  {
+    ICM_20948_Status_e cfgret = ICM_20948_set_bank(pdev, 2);
+    ICM_20948_ACCEL_CONFIG_t acfg;
+    cfgret |= ICM_20948_execute_r(pdev, (uint8_t)AGB2_REG_ACCEL_CONFIG, (uint8_t *)&acfg, 1 * sizeof(acfg));
+    pdev->_fss.a = acfg.ACCEL_FS_SEL; // Worth noting that without explicitly setting the FS range of the accelerometer it was showing the register value for +/- 2g but the reported values were actually scaled to the +/- 16g range
+                                      // Wait a minute... now it seems like this problem actually comes from the digital low-pass filter. When enabled the value is 1/8 what it should be...
+    ICM_20948_GYRO_CONFIG_1_t gcfg1;
+    cfgret |= ICM_20948_execute_r(pdev, (uint8_t)AGB2_REG_GYRO_CONFIG_1, (uint8_t *)&gcfg1, 1 * sizeof(gcfg1));
+    pdev->_fss.g = gcfg1.GYRO_FS_SEL;
+    pdev->_fss_cached = (cfgret == ICM_20948_Stat_Ok);
+    retval |= cfgret;
+  }
+  pagmt->fss = pdev->_fss;
 
   return retval;
 }
@@ -1250,6 +1273,7 @@ ICM_20948_Status_e ICM_20948_read_FIFO(ICM_20948_Device_t *pdev, uint8_t *data,
 }
 
 // DMP
+#if !defined(ICM_20948_SLIM)
 
 ICM_20948_Status_e ICM_20948_enable_DMP(ICM_20948_Device_t *pdev, bool enable)
 {
@@ -1317,7 +1341,61 @@ ICM_20948_Status_e ICM_20948_firmware_load(ICM_20948_Device_t *pdev)
 #endif
 }
 
+// Firmware load/verify burst: at most one DMP memory bank (256 bytes) per
+// MEM_START_ADDR write. PROGMEM images go through a stack buffer of this size.
+#ifndef INV_FIRMWARE_BURST
+#ifdef ICM_20948_USE_PROGMEM_FOR_DMP
+#define INV_FIRMWARE_BURST 128
+#else
+#define INV_FIRMWARE_BURST 256
+#endif
+#endif
+
+// CRC-16/CCITT (poly 0x1021, init 0xFFFF), byte-wise without a table
+static unsigned short inv_crc16_update(unsigned short crc, const unsigned char *data, unsigned short len)
+{
+  while (len--)
+  {
+    unsigned char x = (crc >> 8) ^ *data++;
+    x ^= x >> 4;
+    crc = (crc << 8) ^ ((unsigned short)x << 12) ^ ((unsigned short)x << 5) ^ x;
+  }
+  return crc;
+}
+
+// Largest burst from memaddr that stays inside its 256-byte memory bank
+static unsigned short inv_firmware_burst(unsigned short memaddr, unsigned short size)
+{
+  unsigned short len = 0x100 - (memaddr & 0xff);
+  if (len > INV_FIRMWARE_BURST)
+    len = INV_FIRMWARE_BURST;
+  if (len > size)
+    len = size;
+  return len;
+}
+
+// Point MEM_R_W at memaddr: MEM_BANK_SEL only when the bank changes, MEM_START_ADDR every burst
+static ICM_20948_Status_e inv_firmware_seek(ICM_20948_Device_t *pdev, unsigned short memaddr)
+{
+  ICM_20948_Status_e result;
+  unsigned char bank = memaddr >> 8;
+  unsigned char start = memaddr & 0xff;
+
+  if (bank != pdev->_last_mems_bank)
+  {
+    pdev->_last_mems_bank = bank;
+    result = ICM_20948_execute_w(pdev, AGB0_REG_MEM_BANK_SEL, &bank, 1);
+    if (result != ICM_20948_Stat_Ok)
+      return result;
+  }
+  return ICM_20948_execute_w(pdev, AGB0_REG_MEM_START_ADDR, &start, 1);
+}
+
 /** @brief Loads the DMP firmware from SRAM
+* Each burst runs to the end of its memory bank (up to INV_FIRMWARE_BURST
+* bytes) instead of INV_MAX_SERIAL_WRITE. Unless ICM_20948_DMP_SKIP_VERIFY is
+* defined, the memory is then read back in the same bursts and its CRC-16
+* compared with the CRC of the image taken while writing.
 * @param[in] data  pointer where the image
 * @param[in] size  size if the image
 * @param[in] load_addr  address to loading the image
@@ -1325,13 +1403,13 @@ ICM_20948_Status_e ICM_20948_firmware_load(ICM_20948_Device_t *pdev)
 */
 ICM_20948_Status_e inv_icm20948_firmware_load(ICM_20948_Device_t *pdev, const unsigned char *data_start, unsigned short size_start, unsigned short load_addr)
 {
-  int write_size;
+  unsigned short burst;
   ICM_20948_Status_e result = ICM_20948_Stat_Ok;
   unsigned short memaddr;
   const unsigned char *data;
   unsigned short size;
-  unsigned char data_cmp[INV_MAX_SERIAL_READ];
-  int flag = 0;
+  unsigned short image_crc = 0xFFFF;
+  unsigned char buff[INV_FIRMWARE_BURST];
 
   if (pdev->_dmp_firmware_available == false)
     return ICM_20948_Stat_DMPNotSupported;
@@ -1351,81 +1429,70 @@ ICM_20948_Status_e inv_icm20948_firmware_load(ICM_20948_Device_t *pdev, const un
     return result;
   }
 
+  result = ICM_20948_set_bank(pdev, 0); // MEM_* registers are in bank 0
+  if (result != ICM_20948_Stat_Ok)
+  {
+    return result;
+  }
+
   // Write DMP memory
 
   data = data_start;
   size = size_start;
   memaddr = load_addr;
-  #ifdef ICM_20948_USE_PROGMEM_FOR_DMP
-  unsigned char data_not_pg[INV_MAX_SERIAL_READ]; // Suggested by @HyperKokichi in Issue #63
-  #endif
   while (size > 0)
   {
-    //write_size = min(size, INV_MAX_SERIAL_WRITE); // Write in chunks of INV_MAX_SERIAL_WRITE
-    if (size <= INV_MAX_SERIAL_WRITE) // Write in chunks of INV_MAX_SERIAL_WRITE
-      write_size = size;
-    else
-      write_size = INV_MAX_SERIAL_WRITE;
-    if ((memaddr & 0xff) + write_size > 0x100)
-    {
-      // Moved across a bank
-      write_size = (memaddr & 0xff) + write_size - 0x100;
-    }
+    burst = inv_firmware_burst(memaddr, size);
+    result = inv_firmware_seek(pdev, memaddr);
+    if (result != ICM_20948_Stat_Ok)
+      return result;
 #ifdef ICM_20948_USE_PROGMEM_FOR_DMP
-    memcpy_P(data_not_pg, data, write_size);  // Suggested by @HyperKokichi in Issue #63
-    result = inv_icm20948_write_mems(pdev, memaddr, write_size, (unsigned char *)data_not_pg);
+    memcpy_P(buff, data, burst); // Suggested by @HyperKokichi in Issue #63
+    image_crc = inv_crc16_update(image_crc, buff, burst);
+    result = ICM_20948_execute_w(pdev, AGB0_REG_MEM_R_W, buff, burst);
 #else
-    result = inv_icm20948_write_mems(pdev, memaddr, write_size, (unsigned char *)data);
+    image_crc = inv_crc16_update(image_crc, data, burst);
+    result = ICM_20948_execute_w(pdev, AGB0_REG_MEM_R_W, (uint8_t *)data, burst);
 #endif
     if (result != ICM_20948_Stat_Ok)
       return result;
-    data += write_size;
-    size -= write_size;
-    memaddr += write_size;
+    data += burst;
+    size -= burst;
+    memaddr += burst;
   }
 
+#ifndef ICM_20948_DMP_SKIP_VERIFY
   // Verify DMP memory
 
-  data = data_start;
+  unsigned short mem_crc = 0xFFFF;
   size = size_start;
   memaddr = load_addr;
   while (size > 0)
   {
-    //write_size = min(size, INV_MAX_SERIAL_READ); // Read in chunks of INV_MAX_SERIAL_READ
-    if (size <= INV_MAX_SERIAL_READ) // Read in chunks of INV_MAX_SERIAL_READ
-      write_size = size;
-    else
-      write_size = INV_MAX_SERIAL_READ;
-    if ((memaddr & 0xff) + write_size > 0x100)
-    {
-      // Moved across a bank
-      write_size = (memaddr & 0xff) + write_size - 0x100;
-    }
-    result = inv_icm20948_read_mems(pdev, memaddr, write_size, data_cmp);
+    burst = inv_firmware_burst(memaddr, size);
+    result = inv_firmware_seek(pdev, memaddr);
     if (result != ICM_20948_Stat_Ok)
-      flag++;                               // Error, DMP not written correctly
-#ifdef ICM_20948_USE_PROGMEM_FOR_DMP
-    memcpy_P(data_not_pg, data, write_size);  // Suggested by @HyperKokichi in Issue #63
-    if (memcmp(data_cmp, data_not_pg, write_size))
+      return result;
+    result = ICM_20948_execute_r(pdev, AGB0_REG_MEM_R_W, buff, burst);
+    if (result != ICM_20948_Stat_Ok)
+      return result;
+    mem_crc = inv_crc16_update(mem_crc, buff, burst);
+    size -= burst;
+    memaddr += burst;
+  }
+  if (mem_crc != image_crc)
+    return ICM_20948_Stat_DMPVerifyFail;
 #else
-    if (memcmp(data_cmp, data, write_size)) // Compare the data
+  (void)image_crc;
 #endif
-      return ICM_20948_Stat_DMPVerifyFail;
-    data += write_size;
-    size -= write_size;
-    memaddr += write_size;
-  }
 
   //Enable LP_EN since we disabled it at begining of this function.
   result = ICM_20948_low_power(pdev, true); // Put chip into low power state
   if (result != ICM_20948_Stat_Ok)
     return result;
 
-  if (!flag)
-  {
-    //Serial.println("DMP Firmware was updated successfully..");
-    pdev->_firmware_loaded = true;
-  }
+  //Serial.println("DMP Firmware was updated successfully..");
+  pdev->_firmware_loaded = true;
 
   return result;
 }
@@ -2632,5 +2699,4 @@ ICM_20948_Status_e inv_icm20948_set_gyro_sf(ICM_20948_Device_t *pdev, unsigned c
 
   return result;
 }
-
-
+#endif // ICM_20948_SLIM
@@ -33,6 +33,13 @@ extern int memcmp(const void *, const void *, size_t); // Avoid compiler warning
 // Note: you must have 14290/14301 Bytes of program memory available to store the DMP firmware!
 //#define ICM_20948_USE_DMP // Uncomment this line to enable DMP support. You can of course use ICM_20948_USE_DMP as a compiler flag too
 
+// Define (as a compiler flag) for a slim build on small AVRs: compiles out the DMP API and its
+// tables, the debug printing and statusString(). Register, FIFO and magnetometer access remain.
+//#define ICM_20948_SLIM
+#if defined(ICM_20948_SLIM) && defined(ICM_20948_USE_DMP)
+#error "ICM_20948_SLIM compiles out the DMP; define only one of ICM_20948_SLIM and ICM_20948_USE_DMP"
+#endif
+
 // There are two versions of the InvenSense DMP firmware for the ICM20948 - with slightly different sizes
 #define DMP_CODE_SIZE 14301 /* eMD-SmartMotion-ICM20948-1.1.0-MP */
 //#define DMP_CODE_SIZE 14290 /* ICM20948_eMD_nucleo_1.0 */
@@ -187,6 +194,10 @@ extern int memcmp(const void *, const void *, size_t); // Avoid compiler warning
     uint16_t _dataRdyStatus;          // Diagnostics: record the setting of DATA_RDY_STATUS
     uint16_t _motionEventCtl;         // Diagnostics: record the setting of MOTION_EVENT_CTL
     uint16_t _dataIntrCtl;            // Diagnostics: record the setting of DATA_INTR_CTL
+    ICM_20948_fss_t _fss;             // Cached ACCEL_FS_SEL / GYRO_FS_SEL - only changed by set_full_scale and sw_reset
+    bool _fss_cached;                 // _fss matches the chip (otherwise get_agmt reads it from bank 2)
+    uint32_t _txn_count;              // Serial interface transactions (execute_r / execute_w calls)
+    uint32_t _txn_bytes;              // Bytes on the bus for those transactions (register address + data)
   } ICM_20948_Device_t;               // Definition of device struct type
 
   ICM_20948_Status_e ICM_20948_init_struct(ICM_20948_Device_t *pdev); // Initialize ICM_20948_Device_t
@@ -249,6 +260,7 @@ extern int memcmp(const void *, const void *, size_t); // Avoid compiler warning
   ICM_20948_Status_e ICM_20948_read_FIFO(ICM_20948_Device_t *pdev, uint8_t *data, uint8_t len);
 
   // DMP
+#if !defined(ICM_20948_SLIM)
 
   ICM_20948_Status_e ICM_20948_enable_DMP(ICM_20948_Device_t *pdev, bool enable);
   ICM_20948_Status_e ICM_20948_reset_DMP(ICM_20948_Device_t *pdev);
@@ -287,6 +299,7 @@ extern int memcmp(const void *, const void *, size_t); // Avoid compiler warning
 
   ICM_20948_Status_e inv_icm20948_read_dmp_data(ICM_20948_Device_t *pdev, icm_20948_DMP_data_t *data);
   ICM_20948_Status_e inv_icm20948_set_gyro_sf(ICM_20948_Device_t *pdev, unsigned char div, int gyro_level);
+#endif // ICM_20948_SLIM
 
   // ToDo:
 
@@ -27,9 +27,9 @@ fi
 echo "Setting up test file: ${TEST_FILE}"
 cp "${TEST_FILE}" "${MAIN_FILE}"
 
-# Build and upload
+# Build and upload (examples/ on the include path for test_report.h)
 echo "Building and uploading..."
-pio run --target upload
+PLATFORMIO_BUILD_FLAGS="${PLATFORMIO_BUILD_FLAGS} -Iexamples" pio run --target upload
 
 if [ $? -eq 0 ]; then
     # Start monitoring only if upload succeeded
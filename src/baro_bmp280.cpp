@@ -1,7 +1,11 @@
 #include <Arduino.h>
 #include <SPI.h>
+#include <Wire.h>
 #include <Adafruit_BMP280.h>
+#include "config.h"
 #include "baro_bmp280.h"
+#include "baro_gate.h"
+#include "error_log.h"
 
 // Note: Using I2C mode, so SPI pins are not needed
 // #define BMP_CS   3    // Not used in I2C mode
@@ -12,32 +16,154 @@
 #define SEA_LEVEL_PRESSURE 1013.25  // hPa
 #define N 5                         // median filter window size
 
+// Normal mode conversion period: t_standby + t_meas (typ. for T x2, P x16)
+#define BARO_STANDBY_MS 500
+#define BARO_MEASURE_MS 38
+#define BARO_PERIOD_US ((BARO_STANDBY_MS + BARO_MEASURE_MS) * 1000UL)
+
+// Status register (0xF3) bits
+#define BMP280_STATUS_MEASURING 0x08  // Conversion running
+#define BMP280_STATUS_IM_UPDATE 0x01  // NVM copy to image registers
+
+// ctrl_meas for a single forced conversion: osrs_t x2, osrs_p x16, mode forced
+#define BMP280_CTRL_FORCED ((Adafruit_BMP280::SAMPLING_X2 << 5) | \
+                            (Adafruit_BMP280::SAMPLING_X16 << 2) | \
+                            Adafruit_BMP280::MODE_FORCED)
+
 Adafruit_BMP280 bmp; // I2C mode (default)
 
+// Last delivered sample, handed back when no new conversion is available
+BaroData lastData;
+bool haveSample = false;
+bool conversionSeen = false;      // Saw MEASURING since the last read
+unsigned long lastSampleUs = 0;
+float sampleRateHz = 0.0;
+
+// Welford running mean/variance. Once n reaches BARO_STATS_WINDOW it is
+// halved (m2 with it), so old samples fade instead of pinning the estimate.
+struct RunningStats {
+  uint16_t n;
+  float mean;
+  float m2;
+};
+
+RunningStats pressureStats = {0, 0.0, 0.0};
+RunningStats temperatureStats = {0, 0.0, 0.0};
+
+// Spike rejection against the predicted altitude
+BaroGate gate;
+
+// Forced mode tick state
+BaroMode baroMode = BARO_MODE_NORMAL;
+BaroMode baseMode = BARO_MODE_NORMAL;  // Mode from initBaro(), restored after idle
+unsigned long tickMs = BARO_TICK_MS;
+bool baroIdle = false;
+unsigned long nextTickUs = 0;     // Scheduled time of the next trigger
+unsigned long triggerUs = 0;      // When the pending conversion was started
+bool conversionPending = false;
+long tickJitterUs = 0;            // Lateness of the most recent tick
+
 // Median filter buffer
 float altBuf[N];
 int altIndex = 0;
 
+// Pad reference (ground level) pressure
+float calBuf[BARO_CAL_SAMPLES];
+uint8_t calCount = 0;
+float refPressure = 0.0;
+float refAltitude = 0.0;
+bool refValid = false;
+bool baroArmed = false;
+
 // Compute altitude from pressure
 float calculateAltitude(float pressure_hPa, float seaLevel_hPa) {
   return 44330.0 * (1.0 - pow(pressure_hPa / seaLevel_hPa, 0.1903));
 }
 
+// In-place sort for the small filter/calibration buffers
+void sortFloats(float *v, int n) {
+  for (int i = 0; i < n - 1; i++) {
+    for (int j = i + 1; j < n; j++) {
+      if (v[j] < v[i]) {
+        float tmp = v[i];
+        v[i] = v[j];
+        v[j] = tmp;
+      }
+    }
+  }
+}
+
 // Median filter
 float filterAltitude(float newAlt) {
   altBuf[altIndex++ % N] = newAlt;
   float sorted[N];
   memcpy(sorted, altBuf, sizeof(sorted));
-  for (int i = 0; i < N - 1; i++) {
-    for (int j = i + 1; j < N; j++) {
-      if (sorted[j] < sorted[i]) {
-        float tmp = sorted[i];
-        sorted[i] = sorted[j];
-        sorted[j] = tmp;
-      }
+  sortFloats(sorted, N);
+  return sorted[N / 2];
+}
+
+void setReference(float pressure) {
+  refPressure = pressure;
+  refAltitude = calculateAltitude(pressure, SEA_LEVEL_PRESSURE);
+  refValid = true;
+}
+
+// Average the collected pad samples, dropping any too far from the median.
+// Returns false (and restarts collection) if fewer than half survive.
+bool finishCalibration() {
+  if (calCount == 0) return false;
+
+  sortFloats(calBuf, calCount);
+  float median = calBuf[calCount / 2];
+
+  float sum = 0.0;
+  uint8_t kept = 0;
+  for (uint8_t i = 0; i < calCount; i++) {
+    if (fabs(calBuf[i] - median) <= BARO_CAL_REJECT_HPA) {
+      sum += calBuf[i];
+      kept++;
     }
   }
-  return sorted[N / 2];
+
+  uint8_t collected = calCount;
+  calCount = 0;
+  if (kept * 2 < collected) return false;
+
+  setReference(sum / kept);
+  return true;
+}
+
+// Feed a validated pressure sample into the pad reference
+void updateReference(float pressure) {
+  if (!refValid) {
+    if (baroArmed) {
+      setReference(pressure);  // Armed before any pad samples: best effort
+      return;
+    }
+    calBuf[calCount++] = pressure;
+    if (calCount >= BARO_CAL_SAMPLES) finishCalibration();
+    return;
+  }
+
+  if (baroArmed) return;  // Frozen while armed
+
+  // Follow slow weather/thermal drift while waiting on the pad
+  setReference(refPressure + (pressure - refPressure) / BARO_REF_TRACK_DIV);
+}
+
+void updateStats(RunningStats &st, float x) {
+  if (st.n >= BARO_STATS_WINDOW) {
+    st.n /= 2;
+    st.m2 /= 2.0;
+  }
+  st.n++;
+  float delta = x - st.mean;
+  st.mean += delta / st.n;
+  st.m2 += delta * (x - st.mean);
+}
+
+float statsStdDev(const RunningStats &st) {
+  return st.n > 1 ? sqrt(st.m2 / (st.n - 1)) : 0.0;
 }
 
 // Plausibility check
@@ -48,7 +174,7 @@ bool validReading(float temp, float press) {
   return true;
 }
 
-bool initBaro() {
+bool initBaro(BaroMode mode) {
   Serial.println(F("Initializing BMP280 (I2C mode)..."));
   
   if (!bmp.begin()) {
@@ -63,19 +189,113 @@ bool initBaro() {
 
   Serial.println(F("✓ BMP280 initialized successfully!"));
 
+  baroMode = mode;
+  baseMode = mode;
+  resetBaroGate(gate);
   bmp.setSampling(
-    Adafruit_BMP280::MODE_NORMAL,
+    mode == BARO_MODE_FORCED ? Adafruit_BMP280::MODE_FORCED : Adafruit_BMP280::MODE_NORMAL,
     Adafruit_BMP280::SAMPLING_X2,
     Adafruit_BMP280::SAMPLING_X16,
     Adafruit_BMP280::FILTER_X16,
-    Adafruit_BMP280::STANDBY_MS_500
+    Adafruit_BMP280::STANDBY_MS_500  // BARO_STANDBY_MS, ignored in forced mode
   );
 
+  if (mode == BARO_MODE_FORCED) {
+    conversionPending = false;
+    nextTickUs = micros();
+    Serial.print(F("Forced mode, tick "));
+    Serial.print(BARO_TICK_MS);
+    Serial.println(F(" ms"));
+  }
+
   Serial.println(F("Configuration complete."));
   return true;
 }
 
+// Start one forced conversion without waiting for it to finish
+// (Adafruit_BMP280::takeForcedMeasurement() blocks until it does)
+void triggerConversion(unsigned long now) {
+  Wire.beginTransmission(BMP280_ADDRESS);
+  Wire.write(BMP280_REGISTER_CONTROL);
+  Wire.write(BMP280_CTRL_FORCED);
+  Wire.endTransmission();
+  triggerUs = now;
+  conversionPending = true;
+}
+
+// Forced mode: on each tick, start the next conversion and report whether
+// the one started on the previous tick is ready. sampleUs is its trigger time.
+bool forcedTickReady(unsigned long &sampleUs) {
+  unsigned long now = micros();
+  if ((long)(now - nextTickUs) < 0) return false;
+
+  tickJitterUs = now - nextTickUs;
+  nextTickUs += tickMs * 1000UL;
+  if ((long)(now - nextTickUs) >= 0) {
+    nextTickUs = now + tickMs * 1000UL;  // Missed a whole tick: re-phase
+  }
+
+  // Tick shorter than t_meas: let the running conversion finish
+  if (conversionPending && (bmp.getStatus() & BMP280_STATUS_MEASURING)) return false;
+
+  bool ready = conversionPending;
+  sampleUs = triggerUs;
+  // Trigger first so the conversion starts exactly on the tick; the result
+  // registers are only overwritten once it completes, t_meas from now
+  triggerConversion(now);
+  return ready;
+}
+
+// Pad idle: slow forced conversions, the sensor sleeping in between. Leaving
+// idle restores the initBaro() mode with a conversion starting at once.
+void setBaroIdle(bool idle) {
+  if (idle == baroIdle) return;
+  baroIdle = idle;
+  baroMode = idle ? BARO_MODE_FORCED : baseMode;
+  tickMs = idle ? BARO_IDLE_TICK_MS : BARO_TICK_MS;
+
+  bmp.setSampling(
+    baroMode == BARO_MODE_FORCED ? Adafruit_BMP280::MODE_FORCED : Adafruit_BMP280::MODE_NORMAL,
+    Adafruit_BMP280::SAMPLING_X2,
+    Adafruit_BMP280::SAMPLING_X16,
+    Adafruit_BMP280::FILTER_X16,
+    Adafruit_BMP280::STANDBY_MS_500
+  );
+  conversionPending = false;
+  conversionSeen = false;
+  nextTickUs = micros();
+}
+
+unsigned long baroUsUntilTick() {
+  if (baroMode != BARO_MODE_FORCED) return 0xFFFFFFFFUL;
+  long remaining = (long)(nextTickUs - micros());
+  return remaining > 0 ? (unsigned long)remaining : 0;
+}
+
+// Decide from the status register whether a conversion has completed since
+// the last read, without touching the data registers
+bool newConversionReady() {
+  uint8_t status = bmp.getStatus();
+  if (status & (BMP280_STATUS_MEASURING | BMP280_STATUS_IM_UPDATE)) {
+    conversionSeen = true;  // Result lands once this conversion finishes
+    return false;
+  }
+  if (!haveSample || conversionSeen) return true;
+  // Conversion started and finished between polls
+  return micros() - lastSampleUs >= BARO_PERIOD_US;
+}
+
 bool readBaro(BaroData &data) {
+  unsigned long sampleUs = micros();
+  bool ready = (baroMode == BARO_MODE_FORCED) ? forcedTickReady(sampleUs)
+                                              : newConversionReady();
+  if (!ready) {
+    if (!haveSample) return false;
+    data = lastData;
+    data.fresh = false;
+    return true;
+  }
+
   float temperature = bmp.readTemperature();
   float pressure = bmp.readPressure() / 100.0F; // Pa → hPa
 
@@ -85,16 +305,84 @@ bool readBaro(BaroData &data) {
     temperature = bmp.readTemperature();
     pressure = bmp.readPressure() / 100.0F;
     if (!validReading(temperature, pressure)) {
+      recordError(ERR_BARO_INVALID, 2);
       return false;
     }
+    recordError(ERR_BARO_INVALID, 1);
   }
 
   float altitude = calculateAltitude(pressure, SEA_LEVEL_PRESSURE);
+  float dt = haveSample ? (sampleUs - lastSampleUs) / 1000000.0 : 0.0;
+  bool accepted = baroGateAccept(gate, altitude, dt);
+
+  // Effective sample rate from the spacing of fresh samples
+  if (haveSample && sampleUs != lastSampleUs) {
+    float rate = 1000000.0 / (float)(sampleUs - lastSampleUs);
+    sampleRateHz = (sampleRateHz == 0.0) ? rate : sampleRateHz + (rate - sampleRateHz) / 8.0;
+  }
+  lastSampleUs = sampleUs;
+  conversionSeen = false;
+
+  if (!accepted) {
+    // Spike: this conversion is consumed but kept out of the median filter,
+    // the pad reference and the stats
+    if (!haveSample) return false;
+    data = lastData;
+    data.fresh = false;
+    data.rejectedCount = gate.rejectedCount;
+    return true;
+  }
+  haveSample = true;
+
+  updateReference(pressure);
+  updateStats(pressureStats, pressure);
+  updateStats(temperatureStats, temperature);
+
   altitude = filterAltitude(altitude);
 
   data.temperature = temperature;
   data.pressure = pressure;
   data.altitude = altitude;
+  data.altitudeAGL = refValid ? altitude - refAltitude : 0.0;
+
+  data.fresh = true;
+  data.sampleRateHz = sampleRateHz;
+  data.sampleMicros = sampleUs;
+  data.jitterUs = (baroMode == BARO_MODE_FORCED) ? tickJitterUs : 0;
+  data.rejectedCount = gate.rejectedCount;
+  data.dataValid = true;
+  lastData = data;
 
   return true;
+}
+
+void armBaro() {
+  // Don't fly without a reference: settle for the samples collected so far
+  if (!refValid) finishCalibration();
+  baroArmed = true;
+}
+
+void disarmBaro() {
+  baroArmed = false;
+}
+
+bool isBaroCalibrated() {
+  return refValid;
+}
+
+float getBaroReferencePressure() {
+  return refPressure;
+}
+
+void getBaroStats(BaroStats &stats) {
+  stats.count = pressureStats.n;
+  stats.pressureMean = pressureStats.mean;
+  stats.pressureStdDev = statsStdDev(pressureStats);
+  stats.temperatureMean = temperatureStats.mean;
+  stats.temperatureStdDev = statsStdDev(temperatureStats);
+}
+
+void resetBaroStats() {
+  pressureStats = {0, 0.0, 0.0};
+  temperatureStats = {0, 0.0, 0.0};
 }
\ No newline at end of file
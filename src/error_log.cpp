@@ -0,0 +1,89 @@
+#include "error_log.h"
+#include "config.h"
+
+ErrorEntry errorTable[ERR_SOURCE_COUNT];
+uint16_t reportedCount[ERR_SOURCE_COUNT];  // Counts at the last report
+unsigned long lastReportMillis = 0;
+
+void recordError(ErrorSource source, uint8_t code) {
+  ErrorEntry &entry = errorTable[source];
+  if (entry.count < 0xFFFF) entry.count++;
+  entry.lastCode = code;
+  entry.lastMillis = millis();
+}
+
+uint16_t getErrorCount(ErrorSource source) {
+  return errorTable[source].count;
+}
+
+const ErrorEntry& getErrorEntry(ErrorSource source) {
+  return errorTable[source];
+}
+
+static void printSourceName(uint8_t source) {
+  switch (source) {
+    case ERR_RTC_I2C:        Serial.print(F("RTC_I2C")); break;
+    case ERR_RTC_SHORT_READ: Serial.print(F("RTC_SHORT_READ")); break;
+    case ERR_RTC_RANGE:      Serial.print(F("RTC_RANGE")); break;
+    case ERR_BARO_INVALID:   Serial.print(F("BARO_INVALID")); break;
+    case ERR_SD_NOT_LOGGING: Serial.print(F("SD_NOT_LOGGING")); break;
+    case ERR_SD_NOT_OPEN:    Serial.print(F("SD_NOT_OPEN")); break;
+    case ERR_SD_WRITE:       Serial.print(F("SD_WRITE")); break;
+    case ERR_IMU_FIFO_OVERFLOW: Serial.print(F("IMU_FIFO_OVERFLOW")); break;
+    case ERR_IMU_OVERRUN:    Serial.print(F("IMU_OVERRUN")); break;
+    case ERR_IMU_BIAS:       Serial.print(F("IMU_BIAS")); break;
+    case ERR_IMU_INT:        Serial.print(F("IMU_INT")); break;
+    case ERR_IMU_SPI:        Serial.print(F("IMU_SPI")); break;
+  }
+}
+
+static void printEntry(uint8_t source, uint16_t newCount) {
+  const ErrorEntry &entry = errorTable[source];
+  Serial.print(F("ERR "));
+  printSourceName(source);
+  Serial.print(F(" n="));
+  Serial.print(entry.count);
+  if (newCount) {
+    Serial.print(F(" (+"));
+    Serial.print(newCount);
+    Serial.print(F(")"));
+  }
+  Serial.print(F(" code="));
+  Serial.print(entry.lastCode);
+  Serial.print(F(" at="));
+  Serial.println(entry.lastMillis);
+}
+
+void reportErrors() {
+  unsigned long now = millis();
+  if (now - lastReportMillis < ERROR_REPORT_INTERVAL_MS) return;
+  lastReportMillis = now;
+
+  for (uint8_t i = 0; i < ERR_SOURCE_COUNT; i++) {
+    uint16_t count = errorTable[i].count;
+    if (count != reportedCount[i]) {
+      printEntry(i, count - reportedCount[i]);
+      reportedCount[i] = count;
+    }
+  }
+}
+
+void printErrors() {
+  bool any = false;
+  for (uint8_t i = 0; i < ERR_SOURCE_COUNT; i++) {
+    if (errorTable[i].count) {
+      printEntry(i, 0);
+      any = true;
+    }
+  }
+  if (!any) Serial.println(F("No errors"));
+}
+
+void clearErrors() {
+  for (uint8_t i = 0; i < ERR_SOURCE_COUNT; i++) {
+    errorTable[i].count = 0;
+    errorTable[i].lastCode = 0;
+    errorTable[i].lastMillis = 0;
+    reportedCount[i] = 0;
+  }
+}
@@ -1,7 +1,40 @@
 #include "flight_detection.h"
 #include "sequencer.h"
+#include "imu_icm20948.h"
+#include "launch_detect.h"
 #include <math.h>
 
+LaunchDetector launchDetector;
+int16_t latestAccel[3] = {0, 0, LAUNCH_COUNTS_PER_G};
+
+void serviceLaunchDetector() {
+  // A loop pass (>= 10 ms) outlasts one block (~7 ms of samples): drain
+  // until a short block so the backlog never reaches the overflow reset
+  IMUBlock block;
+  bool latched = false;
+  for (uint8_t b = 0; b < IMU_FIFO_MAX_BLOCKS && readIMUBlock(block); b++) {
+    for (uint8_t i = 0; i < block.count; i++) {
+      unsigned long sampleUs = block.firstSampleUs + (unsigned long)i * block.periodUs;
+      latched |= launchDetectorUpdate(launchDetector, block.accel[i], sampleUs);
+    }
+    memcpy(latestAccel, block.accel[block.count - 1], sizeof(latestAccel));
+    if (block.count < IMU_FIFO_BATCH) break;
+  }
+
+  // Act now rather than on the next sequencer tick
+  if (latched) sequencerOnLaunch();
+}
+
+unsigned long getLaunchMicros() {
+  return launchDetector.launchUs;
+}
+
+void getLatestAccel(float &x, float &y, float &z) {
+  x = latestAccel[0] / (float)LAUNCH_COUNTS_PER_G;
+  y = latestAccel[1] / (float)LAUNCH_COUNTS_PER_G;
+  z = latestAccel[2] / (float)LAUNCH_COUNTS_PER_G;
+}
+
 void updateFlightDetection() {
   // Calculate vertical velocity (simplified)
   sequencerData.vertical_velocity = calculateVerticalVelocity();
@@ -11,7 +44,7 @@ void updateFlightDetection() {
 }
 
 bool detectLaunch() {
-  return (sequencerData.accel_magnitude > LAUNCH_ACCEL_THRESHOLD_G);
+  return launchDetector.launched;
 }
 
 bool detectApogee() {
@@ -3,6 +3,9 @@
 #include "temp.h"
 #include "gps.h"
 #include "config.h"
+#include "timed_output.h"
+
+static TimedOutputs pyroOutputs;
 
 void initHardware() {
   Serial.println(F("Initializing hardware control pins..."));
@@ -19,6 +22,8 @@ void initHardware() {
   pinMode(STATUS_LED_PIN, OUTPUT);
   pinMode(BUZZER_PIN, OUTPUT);
   
+  initTimedOutputs(pyroOutputs, digitalWrite);
+  
   // Ensure all deployment systems are safe
   safeAllPyrotechnics();
   
@@ -28,43 +33,45 @@ void initHardware() {
   Serial.println(F("Hardware initialization complete"));
 }
 
+// Pulse ends in servicePyroOutputs(), the caller doesn't wait for it
+static void firePyro(uint8_t pin) {
+  if (!timedOutputPulse(pyroOutputs, pin, PYRO_PULSE_MS, millis())) {
+    Serial.println(F("ERROR: No free pyro timer"));
+  }
+}
+
+uint8_t servicePyroOutputs() {
+  return timedOutputService(pyroOutputs, millis());
+}
+
 void igniteBooster() {
   Serial.println(F(">>> BOOSTER IGNITION <<<"));
-  digitalWrite(BOOSTER_IGNITION_PIN, HIGH);
-  delay(100); // Brief pulse
-  digitalWrite(BOOSTER_IGNITION_PIN, LOW);
+  firePyro(BOOSTER_IGNITION_PIN);
 }
 
 void popNoseFairing() {
   Serial.println(F(">>> NOSE FAIRING DEPLOYMENT <<<"));
-  digitalWrite(NOSE_FAIRING_PIN, HIGH);
-  delay(100);
-  digitalWrite(NOSE_FAIRING_PIN, LOW);
+  firePyro(NOSE_FAIRING_PIN);
 }
 
 void separateStage() {
   Serial.println(F(">>> STAGE SEPARATION <<<"));
-  digitalWrite(STAGE_SEPARATION_PIN, HIGH);
-  delay(100);
-  digitalWrite(STAGE_SEPARATION_PIN, LOW);
+  firePyro(STAGE_SEPARATION_PIN);
 }
 
 void deployPayload() {
   Serial.println(F(">>> PAYLOAD DEPLOYMENT <<<"));
-  digitalWrite(PAYLOAD_DEPLOY_PIN, HIGH);
-  delay(100);
-  digitalWrite(PAYLOAD_DEPLOY_PIN, LOW);
+  firePyro(PAYLOAD_DEPLOY_PIN);
 }
 
 void deployParachute() {
   Serial.println(F(">>> PARACHUTE DEPLOYMENT <<<"));
-  digitalWrite(PARACHUTE_DEPLOY_PIN, HIGH);
-  delay(100);
-  digitalWrite(PARACHUTE_DEPLOY_PIN, LOW);
+  firePyro(PARACHUTE_DEPLOY_PIN);
 }
 
 void safeAllPyrotechnics() {
   Serial.println(F("Safing all pyrotechnic systems"));
+  timedOutputCancelAll(pyroOutputs);
   digitalWrite(BOOSTER_IGNITION_PIN, LOW);
   digitalWrite(NOSE_FAIRING_PIN, LOW);
   digitalWrite(STAGE_SEPARATION_PIN, LOW);
@@ -1,48 +1,651 @@
 #include "imu_icm20948.h"
 #include "config.h"
 #include <SPI.h>
+#include <EEPROM.h>
 #include "ICM_20948.h"  // SparkFun ICM-20948 library
+#include "error_log.h"
 
 // Create ICM20948 object
 ICM_20948_SPI myICM;
 
+// FIFO mode: one packet is accel XYZ then gyro XYZ, big-endian int16
+#define IMU_FIFO_PACKET 12
+#define IMU_FIFO_SIZE 512
+#define IMU_FIFO_PERIOD_US ((1 + IMU_FIFO_SMPLRT_DIV) * 1000000UL / 1125)
+#define IMU_FIFO_EN_2_ACCEL_GYRO 0x1E  // ACCEL_FIFO_EN | GYRO_{Z,Y,X}_FIFO_EN
+#define IMU_ODR_ALIGN_EN 0x01
+#define IMU_PWR_MGMT_2_GYRO_OFF 0x07     // DISABLE_GYRO (all axes)
+#define IMU_WOM_COMPARE_PREVIOUS 1       // ACCEL_INTEL_MODE_INT
+#define IMU_MAG_DLY_MASK 0x1F            // I2C_PERIPH4_CTRL.I2C_MST_DLY
+#define IMU_MAG_PERIPH0_DELAY_EN 0x01    // I2C_MST_DELAY_CTRL
+#define IMU_MAG_FRAME 9                  // ST1, HXL..HZH, TMPS, ST2 (little-endian)
+#define AK09916_ST2_HOFL 0x08            // Magnetic sensor overflow
+
+static const MagCalibration magCal = {MAG_CAL_OFFSET, MAG_CAL_SOFT};
+
+#define IMU_DMP_ACCEL_LSB_PER_G 8192.0  // ±4 g, fixed by initializeDMP()
+#define IMU_DMP_QUAT_SCALE 1073741824.0  // Q30
+#define IMU_GRAVITY_MS2 9.80665
+#define IMU_DMP_MAX_FRAMES 8             // Frames drained per readIMUAttitude()
+
+bool fifoActive = false;
+bool fifoBacklog = false;                // Last block left samples in the FIFO
+bool dmpActive = false;
+bool womArmed = false;
+bool womResumeFifo = false;              // FIFO was running when WOM was armed
+int16_t dmpAccel[3];                     // Newest DMP accel frame (raw counts)
+
+// Data-ready interrupt: the ISR only timestamps edges; readIMU() and
+// readIMUBlock() service them from the loop
+volatile unsigned long drdyMicros = 0;
+volatile uint16_t drdyCount = 0;
+uint16_t seenDrdyCount = 0;
+bool drdyInterrupt = false;
+
+static void imuDataReadyISR() {
+  drdyMicros = micros();
+  drdyCount++;
+}
+
+// Latest edge and the number of edges since the last call
+static uint16_t takeDataReady(unsigned long &edgeMicros) {
+  noInterrupts();
+  uint16_t count = drdyCount;
+  edgeMicros = drdyMicros;
+  interrupts();
+  uint16_t edges = count - seenDrdyCount;
+  seenDrdyCount = count;
+  return edges;
+}
+
+IMUBusStats busStats;
+unsigned long busStartUs;
+uint32_t imuSpiFreq = 0;                 // Clock initIMU() settled on
+
+// Bracket one IMU read: a single SPI transaction for all its register
+// accesses, timed and counted into busStats
+static void beginIMURead() {
+  myICM.resetTransactionCount();
+  busStartUs = micros();
+  myICM.beginBatch();
+}
+
+static void endIMURead() {
+  myICM.endBatch();
+  unsigned long elapsed = micros() - busStartUs;
+  busStats.reads++;
+  busStats.totalUs += elapsed;
+  if (elapsed > busStats.maxUs) busStats.maxUs = elapsed > 0xFFFF ? 0xFFFF : elapsed;
+  busStats.transactions += myICM.getTransactionCount();
+  busStats.bytes += myICM.getTransactionBytes();
+}
+
+void getIMUBusStats(IMUBusStats &stats) {
+  stats = busStats;
+}
+
+void resetIMUBusStats() {
+  memset(&busStats, 0, sizeof(busStats));
+}
+
+uint32_t getIMUSpiFreq() {
+  return imuSpiFreq;
+}
+
+// Offset registers: accel in bank 1 (factory trim), gyro in bank 2 (zero
+// after reset). Each axis is an H/L pair.
+static const uint8_t accelOffsetRegs[3] = {AGB1_REG_XA_OFFS_H, AGB1_REG_YA_OFFS_H, AGB1_REG_ZA_OFFS_H};
+static const uint8_t gyroOffsetRegs[3] = {AGB2_REG_XG_OFFS_USRH, AGB2_REG_YG_OFFS_USRH, AGB2_REG_ZG_OFFS_USRH};
+
+uint16_t factoryAccelOffset[3];
+IMUBiasRecord imuBias;
+bool biasLoaded = false;
+
+// Write one register in the given bank (for bits the library doesn't wrap)
+static bool writeIMURegister(uint8_t bank, uint8_t reg, uint8_t value) {
+  if (myICM.setBank(bank) != ICM_20948_Stat_Ok) return false;
+  return myICM.write(reg, &value, 1) == ICM_20948_Stat_Ok;
+}
+
+static bool readIMURegister16(uint8_t bank, uint8_t reg, uint16_t &value) {
+  uint8_t buf[2];
+  if (myICM.setBank(bank) != ICM_20948_Stat_Ok) return false;
+  if (myICM.read(reg, buf, 2) != ICM_20948_Stat_Ok) return false;
+  value = (buf[0] << 8) | buf[1];
+  return true;
+}
+
+static bool writeIMURegister16(uint8_t bank, uint8_t reg, uint16_t value) {
+  uint8_t buf[2] = {(uint8_t)(value >> 8), (uint8_t)value};
+  if (myICM.setBank(bank) != ICM_20948_Stat_Ok) return false;
+  return myICM.write(reg, buf, 2) == ICM_20948_Stat_Ok;
+}
+
+// Write a record's biases (or none, for rec == NULL) into the chip
+static bool applyIMUBias(const IMUBiasRecord *rec) {
+  bool ok = true;
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    int16_t accel = rec ? rec->accel[axis] : 0;
+    int16_t gyro = rec ? rec->gyro[axis] : 0;
+    ok &= writeIMURegister16(1, accelOffsetRegs[axis], accelOffsetRegister(factoryAccelOffset[axis], accel));
+    ok &= writeIMURegister16(2, gyroOffsetRegs[axis], gyroOffsetRegister(gyro));
+  }
+  myICM.setBank(0);
+  return ok;
+}
+
+// begin() leaves the AK09916 at 100 Hz, fetched by the I2C master on every
+// sample. Slow both down; the accel/gyro path (FIFO) never carries mag data.
+static bool startIMUMag() {
+  uint8_t mode = IMU_MAG_MODE;
+  if (myICM.writeMag(AK09916_REG_CNTL2, &mode) != ICM_20948_Stat_Ok) return false;
+  bool ok = writeIMURegister(3, AGB3_REG_I2C_MST_DELAY_CTRL, IMU_MAG_PERIPH0_DELAY_EN);
+  myICM.setBank(0);
+  return ok;
+}
+
+// The I2C master runs at the gyro ODR, so the fetch delay follows the divider:
+// 31 (35 Hz) at full rate, 0 (every sample) at IMU_SMPLRT_DIV
+static bool setIMUMagFetch(uint8_t div) {
+  uint16_t samples = (1125 / (1 + div)) / IMU_MAG_FETCH_HZ;
+  uint8_t dly = samples > IMU_MAG_DLY_MASK ? IMU_MAG_DLY_MASK : (samples ? samples - 1 : 0);
+
+  uint8_t ctrl;
+  if (myICM.setBank(3) != ICM_20948_Stat_Ok) return false;
+  if (myICM.read(AGB3_REG_I2C_PERIPH4_CTRL, &ctrl, 1) != ICM_20948_Stat_Ok) return false;
+  bool ok = writeIMURegister(3, AGB3_REG_I2C_PERIPH4_CTRL, (ctrl & ~IMU_MAG_DLY_MASK) | dly);
+  myICM.setBank(0);
+  return ok;
+}
+
+// Accel and gyro ODR = 1125 Hz / (1 + div). The divider only applies with
+// the DLPF enabled.
+static void setIMUSampleRate(uint8_t div) {
+  ICM_20948_dlpcfg_t dlpf;
+  dlpf.a = acc_d246bw_n265bw;
+  dlpf.g = gyr_d196bw6_n229bw8;
+  myICM.setDLPFcfg(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr, dlpf);
+  myICM.enableDLPF(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr, true);
+
+  ICM_20948_smplrt_t rate;
+  rate.a = div;
+  rate.g = div;
+  myICM.setSampleRate(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr, rate);
+  setIMUMagFetch(div);
+}
+
+static bool loadIMUBias() {
+  EEPROM.get(IMU_BIAS_EEPROM_ADDR, imuBias);
+  if (!imuBiasValid(imuBias)) {
+    memset(&imuBias, 0, sizeof(imuBias));
+    recordError(ERR_IMU_BIAS, 1);
+    return false;
+  }
+  if (!applyIMUBias(&imuBias)) {
+    recordError(ERR_IMU_BIAS, 2);
+    return false;
+  }
+  return true;
+}
+
+// Bad WHO_AM_I reads at this clock, all of them if begin() itself failed
+static uint16_t startIMUSpi(uint32_t freq) {
+  myICM.begin(IMU_CS_PIN, SPI, freq);
+  if (myICM.status != ICM_20948_Stat_Ok) return IMU_SPI_CHECK_READS;
+  imuSpiFreq = freq;
+  return validateIMUSpi(IMU_SPI_CHECK_READS);
+}
+
 bool initIMU() {
   SPI.begin();
-  myICM.begin(IMU_CS_PIN, SPI);
-  
-  if (myICM.status != ICM_20948_Stat_Ok) return false;
+
+  // The wiring has to carry IMU_SPI_FREQ cleanly, else drop to the fallback
+  uint16_t mismatches = startIMUSpi(IMU_SPI_FREQ);
+  if (mismatches) {
+    recordError(ERR_IMU_SPI, mismatches > 255 ? 255 : mismatches);
+    if (startIMUSpi(IMU_SPI_FALLBACK_FREQ)) return false;
+  }
   
   ICM_20948_fss_t myFSS;
   myFSS.a = gpm16;
   myFSS.g = dps2000;
   myICM.setFullScale((ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr), myFSS);
+
+  // begin() reset the chip, so the accel offsets hold the factory trim
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    if (!readIMURegister16(1, accelOffsetRegs[axis], factoryAccelOffset[axis])) return false;
+  }
+  myICM.setBank(0);
+  biasLoaded = loadIMUBias();
+  startIMUMag();  // No mag only costs heading, not the flight channels
+
+  // One data-ready edge per sample; without it reads fall back to polling
+  setIMUSampleRate(IMU_SMPLRT_DIV);
+  if (!enableIMUInterrupt()) recordError(ERR_IMU_INT);
   
   return true;
 }
 
+static bool measureIMUBias() {
+  // Measure against the factory trim only
+  if (!applyIMUBias(NULL)) return false;
+  biasLoaded = false;
+
+  int32_t accelSum[3] = {0, 0, 0};
+  int32_t gyroSum[3] = {0, 0, 0};
+  uint16_t samples = 0;
+  unsigned long start = millis();
+  while (samples < IMU_BIAS_SAMPLES) {
+    if (millis() - start > IMU_BIAS_SAMPLES * 10UL) return false;  // Data-ready stuck
+    if (!myICM.dataReady()) continue;
+    const ICM_20948_AGMT_t &agmt = myICM.getAGMT();
+    accelSum[0] += agmt.acc.axes.x;
+    accelSum[1] += agmt.acc.axes.y;
+    accelSum[2] += agmt.acc.axes.z;
+    gyroSum[0] += agmt.gyr.axes.x;
+    gyroSum[1] += agmt.gyr.axes.y;
+    gyroSum[2] += agmt.gyr.axes.z;
+    samples++;
+  }
+
+  IMUBiasRecord rec;
+  if (!computeIMUBias(accelSum, gyroSum, samples, rec)) return false;
+  if (!applyIMUBias(&rec)) return false;
+
+  EEPROM.put(IMU_BIAS_EEPROM_ADDR, rec);
+  imuBias = rec;
+  biasLoaded = true;
+  return true;
+}
+
+bool calibrateIMUBias() {
+  if (fifoActive || dmpActive || womArmed) return false;
+
+  bool hadBias = biasLoaded;
+  setIMUSampleRate(0);  // Full rate: the average takes ~0.2 s, not ~14 s
+  bool ok = measureIMUBias();
+  setIMUSampleRate(IMU_SMPLRT_DIV);
+
+  // A refused calibration (tilted, moving) keeps the stored record in force
+  if (!ok && hadBias) biasLoaded = applyIMUBias(&imuBias);
+
+  // The edges while measuring aren't overruns
+  noInterrupts();
+  seenDrdyCount = drdyCount;
+  interrupts();
+  return ok;
+}
+
+bool imuBiasLoaded() {
+  return biasLoaded;
+}
+
+void getIMUBias(IMUBiasRecord &rec) {
+  rec = imuBias;
+}
+
+// Read WHO_AM_I repeatedly at the current clock, batched as in flight, and
+// count bad reads. initIMU() runs it: any mismatch means the wiring won't
+// carry this clock.
+uint16_t validateIMUSpi(uint16_t reads) {
+  uint16_t mismatches = 0;
+  myICM.beginBatch();
+  for (uint16_t i = 0; i < reads; i++) {
+    uint8_t id = 0;
+    if (myICM.setBank(0) != ICM_20948_Stat_Ok ||
+        myICM.read(AGB0_REG_WHO_AM_I, &id, 1) != ICM_20948_Stat_Ok ||
+        id != ICM_20948_WHOAMI) {
+      mismatches++;
+    }
+  }
+  myICM.endBatch();
+  return mismatches;
+}
+
+bool enableIMUInterrupt() {
+  myICM.cfgIntActiveLow(true);
+  myICM.cfgIntOpenDrain(false);
+  myICM.cfgIntLatch(false);  // 50 us pulse per sample, nothing to clear
+  myICM.intEnableRawDataReady(true);
+  if (myICM.status != ICM_20948_Stat_Ok) return false;
+
+  pinMode(IMU_INT_PIN, INPUT);
+  noInterrupts();
+  seenDrdyCount = drdyCount;
+  interrupts();
+  attachInterrupt(digitalPinToInterrupt(IMU_INT_PIN), imuDataReadyISR, FALLING);
+  drdyInterrupt = true;
+  return true;
+}
+
+bool imuDataPending() {
+  if (!drdyInterrupt) return myICM.dataReady();
+  noInterrupts();
+  bool pending = drdyCount != seenDrdyCount;
+  interrupts();
+  return pending;
+}
+
+bool readIMURaw(IMURawData &raw) {
+  bool ready;
+  if (drdyInterrupt) {
+    uint16_t edges = takeDataReady(raw.sampleMicros);
+    if (edges > 1) recordError(ERR_IMU_OVERRUN, edges > 255 ? 255 : edges);
+    ready = edges > 0;
+    if (ready) beginIMURead();
+  } else {
+    raw.sampleMicros = micros();
+    beginIMURead();
+    ready = myICM.dataReady();
+    if (!ready) endIMURead();
+  }
+
+  if (!ready) {
+    raw.dataValid = false;
+    return false;
+  }
+
+  const ICM_20948_AGMT_t &agmt = myICM.getAGMT();
+  endIMURead();
+  raw.accel[0] = agmt.acc.axes.x;
+  raw.accel[1] = agmt.acc.axes.y;
+  raw.accel[2] = agmt.acc.axes.z;
+  raw.gyro[0] = agmt.gyr.axes.x;
+  raw.gyro[1] = agmt.gyr.axes.y;
+  raw.gyro[2] = agmt.gyr.axes.z;
+  raw.mag[0] = agmt.mag.axes.x;
+  raw.mag[1] = agmt.mag.axes.y;
+  raw.mag[2] = agmt.mag.axes.z;
+  raw.temperature = agmt.tmp.val;
+  raw.fullScale = (agmt.fss.a << 2) | agmt.fss.g;
+  raw.dataValid = true;
+  return true;
+}
+
+// The I2C master's latest copy of the AK09916 registers, one short burst
+bool readIMUMag(int16_t mag[3]) {
+  uint8_t buf[IMU_MAG_FRAME];
+  beginIMURead();
+  bool ok = myICM.setBank(0) == ICM_20948_Stat_Ok &&
+            myICM.read(AGB0_REG_EXT_PERIPH_SENS_DATA_00, buf, IMU_MAG_FRAME) == ICM_20948_Stat_Ok;
+  endIMURead();
+  if (!ok || (buf[8] & AK09916_ST2_HOFL)) return false;
+
+  int16_t raw[3];
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    raw[axis] = (int16_t)((buf[2 + 2 * axis] << 8) | buf[1 + 2 * axis]);
+  }
+  applyMagCalibration(magCal, raw, mag);
+  return true;
+}
+
+void convertIMU(const IMURawData &raw, IMUData &data) {
+  // 16384 LSB/g at ±2 g, halving per FS_SEL step; 131 LSB/dps at ±250 dps
+  float accelScale = IMU_GRAVITY_MS2 / (16384 >> (raw.fullScale >> 2));
+  float gyroScale = DEG_TO_RAD / (131.0 / (1 << (raw.fullScale & 0x03)));
+
+  data.accel_x = raw.accel[0] * accelScale;
+  data.accel_y = raw.accel[1] * accelScale;
+  data.accel_z = raw.accel[2] * accelScale;
+  data.gyro_x = raw.gyro[0] * gyroScale;
+  data.gyro_y = raw.gyro[1] * gyroScale;
+  data.gyro_z = raw.gyro[2] * gyroScale;
+  int16_t mag[3];
+  applyMagCalibration(magCal, raw.mag, mag);
+  data.mag_x = mag[0] * 0.15;
+  data.mag_y = mag[1] * 0.15;
+  data.mag_z = mag[2] * 0.15;
+  data.temperature = raw.temperature / 333.87 + 21.0;
+  data.sampleMicros = raw.sampleMicros;
+  data.dataValid = raw.dataValid;
+}
+
 bool readIMU(IMUData &data) {
-  if (myICM.dataReady()) {
-    myICM.getAGMT();
-    
-    data.accel_x = myICM.accX();
-    data.accel_y = myICM.accY();
-    data.accel_z = myICM.accZ();
-    
-    data.gyro_x = myICM.gyrX();
-    data.gyro_y = myICM.gyrY();
-    data.gyro_z = myICM.gyrZ();
-    
-    data.mag_x = 0;
-    data.mag_y = 0;
-    data.mag_z = 0;
-    data.temperature = 0;
-    
-    data.dataValid = true;
-    return true;
+  IMURawData raw;
+  if (!readIMURaw(raw)) {
+    data.dataValid = false;
+    return false;
   }
-  
-  data.dataValid = false;
+  convertIMU(raw, data);
+  return true;
+}
+
+bool startIMUFifo() {
+  setIMUSampleRate(IMU_FIFO_SMPLRT_DIV);
+
+  // Align accel and gyro ODRs so every packet holds one sample of each
+  if (!writeIMURegister(2, AGB2_REG_ODR_ALIGN_EN, IMU_ODR_ALIGN_EN)) return false;
+  if (!writeIMURegister(0, AGB0_REG_FIFO_EN_2, IMU_FIFO_EN_2_ACCEL_GYRO)) return false;
+
+  myICM.setFIFOmode(false);  // Stream: keep the newest data if we fall behind
+  myICM.enableFIFO(true);
+  myICM.resetFIFO();
+
+  fifoActive = (myICM.status == ICM_20948_Stat_Ok);
+  return fifoActive;
+}
+
+void stopIMUFifo() {
+  writeIMURegister(0, AGB0_REG_FIFO_EN_2, 0);
+  myICM.enableFIFO(false);
+  myICM.resetFIFO();
+  fifoActive = false;
+}
+
+bool readIMUBlock(IMUBlock &block) {
+  block.count = 0;
+  if (!fifoActive) return false;
+
+  // With the interrupt, skip the count read until a sample has landed (or
+  // the last block left some behind) and time the newest one from its edge
+  unsigned long newestUs = micros();
+  if (drdyInterrupt && takeDataReady(newestUs) == 0 && !fifoBacklog) return false;
+  fifoBacklog = false;
+
+  beginIMURead();
+  uint16_t fifoCount;
+  if (myICM.getFIFOcount(&fifoCount) != ICM_20948_Stat_Ok) {
+    endIMURead();
+    return false;
+  }
+
+  // Packets straddling an overflow are misaligned: drop everything
+  if (fifoCount > IMU_FIFO_SIZE - IMU_FIFO_PACKET) {
+    recordError(ERR_IMU_FIFO_OVERFLOW, fifoCount >> 4);
+    myICM.resetFIFO();
+    endIMURead();
+    return false;
+  }
+
+  uint8_t available = fifoCount / IMU_FIFO_PACKET;
+  uint8_t n = available < IMU_FIFO_BATCH ? available : IMU_FIFO_BATCH;
+
+  uint8_t buffer[IMU_FIFO_BATCH * IMU_FIFO_PACKET];
+  bool ok = n > 0 && myICM.readFIFO(buffer, n * IMU_FIFO_PACKET) == ICM_20948_Stat_Ok;
+  endIMURead();
+  if (!ok) return false;
+
+  for (uint8_t i = 0; i < n; i++) {
+    const uint8_t *p = buffer + i * IMU_FIFO_PACKET;
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      block.accel[i][axis] = (int16_t)((p[2 * axis] << 8) | p[2 * axis + 1]);
+      block.gyro[i][axis] = (int16_t)((p[6 + 2 * axis] << 8) | p[7 + 2 * axis]);
+    }
+  }
+
+  // The newest sample in the FIFO was taken at newestUs; we drained the
+  // oldest n of them
+  block.periodUs = IMU_FIFO_PERIOD_US;
+  block.firstSampleUs = newestUs - (unsigned long)(available - 1) * IMU_FIFO_PERIOD_US;
+  block.count = n;
+  fifoBacklog = available > n;
+  return true;
+}
+
+// WOM shares the data-ready ISR: while armed the only INT1 source is motion
+bool armIMUWakeOnMotion() {
+  if (dmpActive) return false;
+  if (womArmed) return true;
+
+  womResumeFifo = fifoActive;
+  if (fifoActive) stopIMUFifo();
+  myICM.intEnableRawDataReady(false);
+
+  // Low-power ODR comes from the sample-rate divider, which needs the DLPF
+  ICM_20948_smplrt_t rate;
+  rate.a = IMU_WOM_SMPLRT_DIV;
+  rate.g = 0;
+  myICM.setSampleRate(ICM_20948_Internal_Acc, rate);
+  myICM.enableDLPF(ICM_20948_Internal_Acc, true);
+  myICM.setSampleMode(ICM_20948_Internal_Acc, ICM_20948_Sample_Mode_Cycled);
+  if (!writeIMURegister(0, AGB0_REG_PWR_MGMT_2, IMU_PWR_MGMT_2_GYRO_OFF)) return false;
+
+  myICM.WOMThreshold(IMU_WOM_THRESHOLD_MG / 4);
+  myICM.WOMLogic(true, IMU_WOM_COMPARE_PREVIOUS);
+  myICM.cfgIntActiveLow(true);
+  myICM.cfgIntOpenDrain(false);
+  myICM.cfgIntLatch(true);  // Held low until INT_STATUS is read
+  myICM.clearInterrupts();
+  myICM.intEnableWOM(true);
+  myICM.lowPower(true);
+  if (myICM.status != ICM_20948_Stat_Ok) return false;
+
+  noInterrupts();
+  seenDrdyCount = drdyCount;
+  interrupts();
+  if (!drdyInterrupt) {
+    pinMode(IMU_INT_PIN, INPUT);
+    attachInterrupt(digitalPinToInterrupt(IMU_INT_PIN), imuDataReadyISR, FALLING);
+  }
+  womArmed = true;
+  return true;
+}
+
+// Back to full rate. The accelerometer is sampling again as soon as this
+// returns; the gyro needs its ~35 ms start-up before its data is valid.
+bool disarmIMUWakeOnMotion() {
+  if (!womArmed) return true;
+  womArmed = false;
+
+  myICM.lowPower(false);
+  bool ok = writeIMURegister(0, AGB0_REG_PWR_MGMT_2, 0x00);
+  myICM.setSampleMode(ICM_20948_Internal_Acc, ICM_20948_Sample_Mode_Continuous);
+  myICM.intEnableWOM(false);
+  myICM.WOMLogic(false, IMU_WOM_COMPARE_PREVIOUS);
+  myICM.cfgIntLatch(false);
+  myICM.clearInterrupts();
+
+  if (womResumeFifo) {
+    ok &= startIMUFifo();
+  } else {
+    setIMUSampleRate(IMU_SMPLRT_DIV);
+  }
+
+  if (drdyInterrupt) {
+    myICM.intEnableRawDataReady(true);
+  } else {
+    detachInterrupt(digitalPinToInterrupt(IMU_INT_PIN));
+  }
+  // The wake edge isn't a sample
+  noInterrupts();
+  seenDrdyCount = drdyCount;
+  interrupts();
+
+  return ok && myICM.status == ICM_20948_Stat_Ok;
+}
+
+bool imuMotionDetected() {
+  if (!womArmed) return false;
+  noInterrupts();
+  bool motion = drdyCount != seenDrdyCount;
+  interrupts();
+  return motion;
+}
+
+IMUDmpStartStats dmpStartStats;
+
+bool startIMUDmp() {
+#if defined(ICM_20948_USE_DMP)
+  fifoActive = false;  // The DMP owns the FIFO from here on
+  // One SPI transaction for the whole ~14 KB firmware load and setup
+  myICM.resetTransactionCount();
+  unsigned long startUs = micros();
+  myICM.beginBatch();
+  bool ok = myICM.initializeDMP() == ICM_20948_Stat_Ok;
+  ok &= myICM.enableDMPSensor(INV_ICM20948_SENSOR_GAME_ROTATION_VECTOR) == ICM_20948_Stat_Ok;
+  ok &= myICM.enableDMPSensor(INV_ICM20948_SENSOR_RAW_ACCELEROMETER) == ICM_20948_Stat_Ok;
+  ok &= myICM.setDMPODRrate(DMP_ODR_Reg_Quat6, IMU_DMP_ODR_DIV) == ICM_20948_Stat_Ok;
+  ok &= myICM.setDMPODRrate(DMP_ODR_Reg_Accel, IMU_DMP_ODR_DIV) == ICM_20948_Stat_Ok;
+  ok &= myICM.enableFIFO() == ICM_20948_Stat_Ok;
+  ok &= myICM.enableDMP() == ICM_20948_Stat_Ok;
+  ok &= myICM.resetDMP() == ICM_20948_Stat_Ok;
+  ok &= myICM.resetFIFO() == ICM_20948_Stat_Ok;
+  myICM.endBatch();
+  dmpStartStats.totalUs = micros() - startUs;
+  dmpStartStats.transactions = myICM.getTransactionCount();
+  dmpStartStats.bytes = myICM.getTransactionBytes();
+  dmpAccel[0] = dmpAccel[1] = 0;
+  dmpAccel[2] = (int16_t)IMU_DMP_ACCEL_LSB_PER_G;
+  dmpActive = ok;
+  return ok;
+#else
   return false;
+#endif
+}
+
+void getIMUDmpStartStats(IMUDmpStartStats &stats) {
+  stats = dmpStartStats;
 }
 
-// Unused functions removed to save memory
\ No newline at end of file
+bool readIMUAttitude(IMUAttitude &att) {
+  att.dataValid = false;
+#if defined(ICM_20948_USE_DMP)
+  if (!dmpActive) return false;
+
+  icm_20948_DMP_data_t frame;
+  bool haveQuat = false;
+  int32_t q1 = 0, q2 = 0, q3 = 0;
+
+  beginIMURead();
+  for (uint8_t i = 0; i < IMU_DMP_MAX_FRAMES; i++) {
+    myICM.readDMPdataFromFIFO(&frame);
+    if (myICM.status != ICM_20948_Stat_Ok && myICM.status != ICM_20948_Stat_FIFOMoreDataAvail) break;
+
+    if (frame.header & DMP_header_bitmap_Accel) {
+      dmpAccel[0] = frame.Raw_Accel.Data.X;
+      dmpAccel[1] = frame.Raw_Accel.Data.Y;
+      dmpAccel[2] = frame.Raw_Accel.Data.Z;
+    }
+    if (frame.header & DMP_header_bitmap_Quat6) {
+      q1 = frame.Quat6.Data.Q1;
+      q2 = frame.Quat6.Data.Q2;
+      q3 = frame.Quat6.Data.Q3;
+      haveQuat = true;
+    }
+    if (myICM.status != ICM_20948_Stat_FIFOMoreDataAvail) break;
+  }
+  endIMURead();
+  if (!haveQuat) return false;
+
+  // DMP sends only the vector part; recover w from the unit norm
+  att.qx = q1 / IMU_DMP_QUAT_SCALE;
+  att.qy = q2 / IMU_DMP_QUAT_SCALE;
+  att.qz = q3 / IMU_DMP_QUAT_SCALE;
+  float w2 = 1.0 - (att.qx * att.qx + att.qy * att.qy + att.qz * att.qz);
+  att.qw = w2 > 0.0 ? sqrt(w2) : 0.0;
+
+  // Gravity direction in the sensor frame, then subtract it (in g)
+  float gx = 2.0 * (att.qx * att.qz - att.qw * att.qy);
+  float gy = 2.0 * (att.qw * att.qx + att.qy * att.qz);
+  float gz = att.qw * att.qw - att.qx * att.qx - att.qy * att.qy + att.qz * att.qz;
+  att.linAccel_x = (dmpAccel[0] / IMU_DMP_ACCEL_LSB_PER_G - gx) * IMU_GRAVITY_MS2;
+  att.linAccel_y = (dmpAccel[1] / IMU_DMP_ACCEL_LSB_PER_G - gy) * IMU_GRAVITY_MS2;
+  att.linAccel_z = (dmpAccel[2] / IMU_DMP_ACCEL_LSB_PER_G - gz) * IMU_GRAVITY_MS2;
+
+  att.sampleMicros = micros();
+  att.dataValid = true;
+  return true;
+#else
+  return false;
+#endif
+}
@@ -2,10 +2,15 @@
 #include <SPI.h>
 #include "config.h"
 #include "baro_bmp280.h"
+#include "imu_icm20948.h"
 #include "rtc_pcf8523.h"
+#include "timebase.h"
 #include "uSD.h"
+#include "error_log.h"
+#include "pad_idle.h"
 
 #define TEST_INTERVAL 500 // 1 second
+#define BARO_POLL_INTERVAL_MS 50 // Poll well inside the ~538 ms conversion period
 #define BUTTON_PIN 4       // Button connected to pin 4
 
 // Button state tracking
@@ -16,6 +21,7 @@ unsigned long debounceDelay = 100;   // 50ms debounce delay
 // Component status tracking
 bool rtcOK = false;
 bool baroOK = false;
+bool imuOK = false;
 bool sdOK = false;
 
 // Buzzer control
@@ -24,30 +30,36 @@ unsigned long beepInterval = 1000;  // Beep every 2 seconds while recording
 unsigned long beepStartTime = 0;
 bool beeping = false;
 
+// Sample record timing
+unsigned long lastRecordTime = 0;
+unsigned long lastMagTime = 0;
+
 // Flight events
-float baseAlt = 0.0;
 bool takeoff = false;
+Timestamp takeoffTime = {0, 0};
 bool landing = false;
 
+// Pad idle: logging and waiting for takeoff, wake-on-motion ends it
+unsigned long padWakeMillis = 0;   // Logging start or last motion
+
 // Error buzzer
 void errorBuzzer() {
   tone(BUZZER_PIN, 1000, 1500);
   delay(1600);
 }
 
-// Helper function to format timestamp
-void formatTimestamp(char* buffer, size_t bufferSize, const DateTime& dt) {
-  snprintf(buffer, bufferSize, "%04d-%02d-%02d %02d:%02d:%02d", 
-           dt.year, dt.month, dt.day, dt.hour, dt.minute, dt.second);
+// Helper function to format timestamp (epoch.mmm, decoded on the host)
+void formatTimestamp(char* buffer, size_t bufferSize, const Timestamp& ts) {
+  snprintf(buffer, bufferSize, "%lu.%03u", (unsigned long)ts.epoch, ts.ms);
 }
 
 // Log system events to main data file
 void logSystemEvent(const char* event, const char* message) {
   // Simplified - only log critical events
-  if (sdOK && isLoggingActive() && rtcOK && strcmp(event, "ERROR") == 0) {
-    DateTime dt;
-    if (readRTC(dt)) {
-      writeData(dt, event, message);
+  if (sdOK && isLoggingActive() && strcmp(event, "ERROR") == 0) {
+    Timestamp ts;
+    if (getTimestamp(ts)) {
+      writeData(ts, event, message);
     }
   }
 }
@@ -84,13 +96,15 @@ void handleButtonPress() {
   if (isLoggingActive()) {
     if (stopLogging()) {
       Serial.println(F("Logging stopped"));
+      disarmBaro();
     }
   } else {
     if (startLogging("data.csv")) {
       Serial.println(F("Logging started"));
-      baseAlt = 0.0;
+      armBaro();
       takeoff = false;
       landing = false;
+      padWakeMillis = millis();
     }
   }
 }
@@ -110,9 +124,10 @@ void handleCommand(char cmd) {
         Serial.println(F("Starting logging..."));
         if (startLogging("data.csv")) {
           Serial.println(F("Logging started"));
-          baseAlt = 0.0;
+          armBaro();
           takeoff = false;
           landing = false;
+          padWakeMillis = millis();
         }
       }
       break;
@@ -124,6 +139,7 @@ void handleCommand(char cmd) {
         Serial.println(F("Stopping logging..."));
         if (stopLogging()) {
           Serial.println(F("Logging stopped"));
+          disarmBaro();
         }
       } else {
         Serial.println(F("Not currently logging"));
@@ -136,6 +152,7 @@ void handleCommand(char cmd) {
       if (isLoggingActive()) {
         Serial.println(F("Stopping logging..."));
         stopLogging();
+        disarmBaro();
       }
       Serial.println(F("Deleting data.csv..."));
       if (deleteFile("data.csv")) {
@@ -145,10 +162,120 @@ void handleCommand(char cmd) {
       }
       break;
       
+    case 'b':
+    case 'B':
+      // Barometer health
+      if (baroOK) {
+        BaroStats stats;
+        getBaroStats(stats);
+        Serial.print(F("Baro n="));
+        Serial.print(stats.count);
+        Serial.print(F(" P="));
+        Serial.print(stats.pressureMean, 2);
+        Serial.print(F("+/-"));
+        Serial.print(stats.pressureStdDev, 3);
+        Serial.print(F("hPa T="));
+        Serial.print(stats.temperatureMean, 1);
+        Serial.print(F("+/-"));
+        Serial.print(stats.temperatureStdDev, 2);
+        Serial.println(F("C"));
+      } else {
+        Serial.println(F("Baro FAILED"));
+      }
+      break;
+      
+    case 't':
+    case 'T': {
+      // Timestamp and aging offset, polled by tools/rtc_calibrate.py
+      Timestamp ts;
+      char timestamp[16];
+      bool valid = getTimestamp(ts);
+      formatTimestamp(timestamp, sizeof(timestamp), ts);
+      Serial.print(F("TIME "));
+      Serial.print(valid ? timestamp : "NO-RTC");
+      Serial.print(F(" OFFSET "));
+      Serial.println(rtcOK ? (int)readRTCOffset() : 0);
+      break;
+    }
+
+    case 'o':
+    case 'O': {
+      // Set aging offset: O<value>, value from tools/rtc_calibrate.py
+      long offset = Serial.parseInt();
+      if (rtcOK && calibrateRTC(RTC_CAL_MODE, (int8_t)constrain(offset, -64, 63))) {
+        Serial.print(F("RTC offset set: "));
+        Serial.println((int)readRTCOffset());
+      } else {
+        Serial.println(F("RTC offset failed"));
+      }
+      break;
+    }
+
+    case 'e':
+    case 'E':
+      // Driver error table
+      printErrors();
+      break;
+
+    case 'c':
+    case 'C':
+      clearErrors();
+      Serial.println(F("Errors cleared"));
+      break;
+
+    case 'i':
+    case 'I':
+      // IMU bias calibration: pad only, board level and still, Z up
+      if (!imuOK) {
+        Serial.println(F("IMU FAILED"));
+      } else if (isLoggingActive()) {
+        Serial.println(F("Stop logging first"));
+      } else if (calibrateIMUBias()) {
+        IMUBiasRecord bias;
+        getIMUBias(bias);
+        Serial.print(F("IMU bias PASS a="));
+        for (uint8_t axis = 0; axis < 3; axis++) {
+          Serial.print(bias.accel[axis]);
+          Serial.print(axis < 2 ? F(",") : F(" g="));
+        }
+        for (uint8_t axis = 0; axis < 3; axis++) {
+          Serial.print(bias.gyro[axis]);
+          if (axis < 2) Serial.print(F(","));
+        }
+        Serial.println();
+      } else {
+        Serial.println(F("IMU bias FAIL (level, still, Z up?)"));
+      }
+      break;
+
+    case 'u':
+    case 'U':
+      // IMU bus time since the last U (SPI clock checked by initIMU)
+      if (imuOK) {
+        IMUBusStats stats;
+        getIMUBusStats(stats);
+        resetIMUBusStats();
+        Serial.print(F("IMU bus "));
+        Serial.print(getIMUSpiFreq());
+        Serial.print(F("Hz n="));
+        Serial.print(stats.reads);
+        Serial.print(F(" avg="));
+        Serial.print(stats.reads ? stats.totalUs / stats.reads : 0);
+        Serial.print(F("us max="));
+        Serial.print(stats.maxUs);
+        Serial.print(F("us txn="));
+        Serial.print(stats.transactions);
+        Serial.print(F(" bytes="));
+        Serial.println(stats.bytes);
+      } else {
+        Serial.println(F("IMU FAILED"));
+      }
+      break;
+
     case 'h':
     case 'H':
       // Show help
-      Serial.println(F("L=Start, S=Stop, D=Delete"));
+      Serial.println(F("L=Start, S=Stop, D=Delete, B=Baro, T=Time, O<n>=RTC offset, E=Errors, C=Clear, I=IMU bias, U=IMU bus"));
       break;
       
     case '\n':
@@ -211,10 +338,15 @@ void setup() {
     } else {
       Serial.println(F("WARNING: Cannot read RTC time"));
     }
+
+    // Anchor the local timebase; the RTC is only re-read to re-sync
+    if (!initTimebase()) {
+      Serial.println(F("WARNING: Timebase not anchored"));
+    }
   }
 
   // Initialize barometer
-  baroOK = initBaro();
+  baroOK = initBaro(BARO_FORCED_MODE ? BARO_MODE_FORCED : BARO_MODE_NORMAL);
   if (!baroOK) {
     Serial.println(F("⚠ Barometer failed"));
     errorBuzzer();
@@ -222,6 +354,15 @@ void setup() {
     Serial.println(F("✓ Barometer OK"));
   }
 
+  // Initialize IMU (raw counts are logged, see tools/decode_log.py)
+  imuOK = initIMU();
+  if (!imuOK) {
+    Serial.println(F("⚠ IMU failed"));
+    errorBuzzer();
+  } else {
+    Serial.println(F("✓ IMU OK"));
+  }
+
   // Initialize microSD card
   sdOK = initSD();
   if (!sdOK) {
@@ -236,6 +377,7 @@ void setup() {
   Serial.println(F("\n=== STATUS ==="));
   Serial.print(F("RTC: ")); Serial.println(rtcOK ? F("OK") : F("FAILED"));
   Serial.print(F("Barometer: ")); Serial.println(baroOK ? F("OK") : F("FAILED"));
+  Serial.print(F("IMU: ")); Serial.println(imuOK ? F("OK") : F("FAILED"));
   Serial.print(F("SD Card: ")); Serial.println(sdOK ? F("OK") : F("FAILED"));
   Serial.println(F("================"));
   
@@ -245,20 +387,18 @@ void setup() {
     Serial.println(F("SD failed"));
   }
 
-  Serial.println(F("\nL=Start, S=Stop, D=Delete"));
+  Serial.println(F("\nL=Start, S=Stop, D=Delete, B=Baro"));
 }
 
 void loop() {
-  // Read RTC data (if available)
-  DateTime dt;
-  char timestamp[32];
-  
-  if (rtcOK && readRTC(dt)) {
-    formatTimestamp(timestamp, sizeof(timestamp), dt);
-  } else {
-    strcpy(timestamp, "NO-RTC");
+  updateTimebase();
+
+  // Motion puts the IMU and baro back at flight rate before this pass samples
+  if (updatePadIdle()) {
+    Serial.println(F("Motion - flight rate"));
+    padWakeMillis = millis();
   }
-  
+
   // Read barometer data (if available)
   BaroData data;
   bool baroDataOK = false;
@@ -270,10 +410,25 @@ void loop() {
     data.temperature = 0.0;
     data.pressure = 0.0;
     data.altitude = 0.0;
+    data.altitudeAGL = 0.0;
+  }
+
+  // One record per new conversion; fall back to a fixed interval without baro
+  bool newRecord = baroDataOK ? data.fresh : (millis() - lastRecordTime >= TEST_INTERVAL);
+  if (newRecord) lastRecordTime = millis();
+
+  // Timestamp from the local timebase (uptime if not anchored)
+  Timestamp ts;
+  char timestamp[16];
+  
+  if (newRecord && getTimestamp(ts)) {
+    formatTimestamp(timestamp, sizeof(timestamp), ts);
+  } else {
+    strcpy(timestamp, "NO-RTC");
   }
 
   // Print sensor data only when logging is active
-  if (isLoggingActive()) {
+  if (newRecord && isLoggingActive()) {
     if (baroDataOK) {
       Serial.print(timestamp);
       Serial.print(F(" "));
@@ -282,22 +437,25 @@ void loop() {
       Serial.print(data.pressure, 1);
       Serial.print(F("hPa "));
       Serial.print(data.altitude, 1);
-      Serial.println(F("m"));
+      Serial.print(F("m "));
+      Serial.print(data.altitudeAGL, 1);
+      Serial.println(F("m AGL"));
       
-      // Flight events
-      if (isLoggingActive() && rtcOK) {
-        if (baseAlt == 0.0 && data.altitude > 0) baseAlt = data.altitude;
-        else if (!takeoff && data.altitude > baseAlt + 1.0) {
+      // Flight events (AGL is relative to the pad reference frozen at arm)
+      if (isLoggingActive() && isTimebaseValid() && isBaroCalibrated()) {
+        if (!takeoff && data.altitudeAGL > ALTITUDE_RISE_THRESHOLD_M) {
           takeoff = true;
+          takeoffTime = ts;
           Serial.println(F("*** TAKEOFF DETECTED! ***"));
-          DateTime dt;
-          if (readRTC(dt)) writeData(dt, "TAKEOFF", "T");
+          writeData(ts, "TAKEOFF", "T");
         }
-        else if (takeoff && !landing && data.altitude < baseAlt + 1.0) {
+        else if (takeoff && !landing && data.altitudeAGL < ALTITUDE_FALL_THRESHOLD_M) {
           landing = true;
           Serial.println(F("*** LANDING DETECTED! ***"));
-          DateTime dt;
-          if (readRTC(dt)) writeData(dt, "LANDING", "L");
+          Serial.print(F("Flight time: "));
+          Serial.print(timestampDiffMs(takeoffTime, ts) / 1000.0, 1);
+          Serial.println(F("s"));
+          writeData(ts, "LANDING", "L");
         }
       }
     } else {
@@ -306,12 +464,34 @@ void loop() {
   }
 
   // Write data to SD card (always try to write if SD available)
-  if (sdOK && isLoggingActive()) {
-    if (!writeData(dt, data)) {
-      Serial.println(F("SD write failed"));
+  if (newRecord && sdOK && isLoggingActive()) {
+    writeData(ts, data);  // Failures are counted in the error table
+  }
+
+  // One IMU row per data-ready sample while logging (none in wake-on-motion)
+  if (imuOK && sdOK && isLoggingActive() && !isPadIdle()) {
+    IMURawData imu;
+    Timestamp imuTs;
+    if (readIMURaw(imu) && getTimestamp(imuTs)) {
+      writeData(imuTs, imu);
+    }
+  }
+
+  // Calibrated mag at the AK09916 rate (IMU rows keep raw mag for re-fitting)
+  if (imuOK && sdOK && isLoggingActive() && !isPadIdle() && millis() - lastMagTime >= IMU_MAG_LOG_MS) {
+    lastMagTime = millis();
+    int16_t mag[3];
+    Timestamp magTs;
+    if (readIMUMag(mag) && getTimestamp(magTs)) {
+      char fields[20];
+      snprintf(fields, sizeof(fields), "%d,%d,%d", mag[0], mag[1], mag[2]);
+      writeRecord(magTs, "MAG", fields);
     }
   }
 
+  // Print driver errors recorded since the last report (rate-limited)
+  reportErrors();
+
   // Update buzzer (beeps while recording)
   updateBuzzer();
 
@@ -335,5 +515,22 @@ void loop() {
     handleCommand(cmd);
   }
 
-  delay(TEST_INTERVAL);
+  // Logging on the pad with no motion for PAD_IDLE_REARM_MS: low power
+  // until the IMU sees motion. Stopping or taking off leaves idle.
+  bool onPad = imuOK && baroOK && isLoggingActive() && !takeoff;
+  if (!onPad) {
+    exitPadIdle();
+  } else if (!isPadIdle() && millis() - padWakeMillis > PAD_IDLE_REARM_MS) {
+    padWakeMillis = millis();
+    enterPadIdle();
+  }
+
+  if (isPadIdle()) {
+    padIdleSleep();  // To the next baro tick or motion
+    return;
+  }
+
+  // Wake for the next forced-mode tick if it comes before the poll interval
+  unsigned long waitMs = baroUsUntilTick() / 1000;
+  delay(waitMs < BARO_POLL_INTERVAL_MS ? waitMs : BARO_POLL_INTERVAL_MS);
 }
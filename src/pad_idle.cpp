@@ -0,0 +1,45 @@
+#include "pad_idle.h"
+#include "config.h"
+#include "imu_icm20948.h"
+#include "baro_bmp280.h"
+#include <avr/sleep.h>
+
+bool padIdle = false;
+
+bool enterPadIdle() {
+  if (padIdle) return true;
+  if (!armIMUWakeOnMotion()) return false;  // No wake source, no idling
+  setBaroIdle(true);
+  padIdle = true;
+  return true;
+}
+
+void exitPadIdle() {
+  if (!padIdle) return;
+  padIdle = false;
+  disarmIMUWakeOnMotion();
+  setBaroIdle(false);
+}
+
+bool isPadIdle() {
+  return padIdle;
+}
+
+bool updatePadIdle() {
+  if (!padIdle || !imuMotionDetected()) return false;
+  exitPadIdle();
+  return true;
+}
+
+// Idle sleep keeps timer0, TWI, SPI and the external interrupts running, so
+// millis() stays right; its 1 ms tick wakes the CPU and the loop puts it
+// straight back to sleep. The INT1 motion edge ends the wait.
+void padIdleSleep() {
+  if (!padIdle) return;
+  unsigned long start = millis();
+  unsigned long waitMs = baroUsUntilTick() / 1000;
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  while (millis() - start < waitMs && !imuMotionDetected()) {
+    sleep_mode();
+  }
+}
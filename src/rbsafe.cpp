@@ -4,6 +4,8 @@
  */
 
 #include "config.h"
+#include "baro_bmp280.h"
+#include "imu_icm20948.h"
 
 class RBSAFEChecker {
 private:
@@ -235,18 +237,18 @@ private:
     }
     
     bool verifyIMUCalibration() {
-        // Check if IMU readings are stable and within expected ranges
+        // Bias record must have loaded from EEPROM (written on the pad by the 'I' command)
         // Should read ~1g on Z-axis, ~0g on X,Y when stationary
         float accelZ = getAccelZ(); // Your IMU reading function
-        return (abs(accelZ - 1.0) < 0.2); // Within 0.2g of 1g
+        return imuBiasLoaded() && (abs(accelZ - 1.0) < 0.2); // Within 0.2g of 1g
     }
     
     bool verifyBarometerBaseline() {
-        // Check barometer reading stability
-        float pressure1 = getBarometricPressure();
-        delay(100);
-        float pressure2 = getBarometricPressure();
-        return (abs(pressure1 - pressure2) < 2.0); // Stable within 2 hPa
+        // Check barometer noise from the streaming stats (no extra reads)
+        BaroStats stats;
+        getBaroStats(stats);
+        return (stats.count >= BARO_STATS_MIN_SAMPLES &&
+                stats.pressureStdDev < BARO_NOISE_MAX_HPA);
     }
     
     bool verifyGPSLock() {
@@ -1,4 +1,5 @@
 #include "rtc_pcf8523.h"
+#include "error_log.h"
 #include <Wire.h>
 
 // PCF8523 I2C address
@@ -15,6 +16,11 @@
 #define PCF8523_WEEKDAYS        0x07
 #define PCF8523_MONTHS          0x08
 #define PCF8523_YEARS           0x09
+#define PCF8523_OFFSET          0x0E
+#define PCF8523_CLKOUT_CONTROL  0x0F
+
+// Control_1 bits
+#define PCF8523_CONTROL_1_SIE   0x04  // Second interrupt enable
 
 // Helper function to convert BCD to decimal
 static uint8_t bcd2dec(uint8_t val) {
@@ -62,9 +68,7 @@ bool readRTC(DateTime &dt) {
   uint8_t error = Wire.endTransmission();
   if (error != 0) {
     dt.dataValid = false;
-    Serial.print(F("  I2C Error Code: "));
-    Serial.println(error);
-    Serial.println(F("  (1=data too long, 2=NACK on addr, 3=NACK on data, 4=other)"));
+    recordError(ERR_RTC_I2C, error);  // 1=data too long, 2=NACK on addr, 3=NACK on data, 4=other
     return false;
   }
   
@@ -74,8 +78,7 @@ bool readRTC(DateTime &dt) {
   uint8_t available = Wire.available();
   if (available < 7) {
     dt.dataValid = false;
-    Serial.print(F("  Expected 7 bytes, got: "));
-    Serial.println(available);
+    recordError(ERR_RTC_SHORT_READ, available);
     return false;
   }
   
@@ -99,6 +102,7 @@ bool readRTC(DateTime &dt) {
   if (dt.second > 59 || dt.minute > 59 || dt.hour > 23 ||
       dt.day < 1 || dt.day > 31 || dt.month < 1 || dt.month > 12) {
     dt.dataValid = false;
+    recordError(ERR_RTC_RANGE, seconds);
     return false;
   }
   
@@ -139,5 +143,72 @@ bool setRTC(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t min
   return true;
 }
 
+// 1 Hz pulse on INT1, as RTClib's RTC_PCF8523::enableSecondTimer():
+// TAM pulsed interrupts, CLKOUT disabled, second interrupt enabled
+bool enableRTCSecondTick() {
+  Wire.beginTransmission(PCF8523_ADDRESS);
+  if (Wire.endTransmission() != 0) return false;
+
+  writeRegister(PCF8523_CLKOUT_CONTROL, readRegister(PCF8523_CLKOUT_CONTROL) | 0xB8);
+  writeRegister(PCF8523_CONTROL_1, readRegister(PCF8523_CONTROL_1) | PCF8523_CONTROL_1_SIE);
+  return true;
+}
+
+// Aging-offset calibration (as RTClib's RTC_PCF8523::calibrate). The register
+// is battery-backed, so one write holds until VBAT is lost.
+bool calibrateRTC(RTCOffsetMode mode, int8_t offset) {
+  if (offset < -64 || offset > 63) return false;
+
+  Wire.beginTransmission(PCF8523_ADDRESS);
+  if (Wire.endTransmission() != 0) return false;
+
+  writeRegister(PCF8523_OFFSET, ((uint8_t)offset & 0x7F) | mode);
+  return true;
+}
+
+int8_t readRTCOffset() {
+  uint8_t raw = readRegister(PCF8523_OFFSET) & 0x7F;
+  return (raw & 0x40) ? (int8_t)(raw | 0x80) : (int8_t)raw;  // Sign-extend 7 bits
+}
+
+// Days since 1970-01-01 (H. Hinnant's days_from_civil, non-negative years)
+static int32_t daysFromCivil(uint16_t y, uint8_t m, uint8_t d) {
+  y -= m <= 2;
+  uint16_t era = y / 400;
+  uint16_t yoe = y - era * 400;
+  uint16_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  uint32_t doe = yoe * 365UL + yoe / 4 - yoe / 100 + doy;
+  return (int32_t)era * 146097L + (int32_t)doe - 719468L;
+}
+
+uint32_t dateTimeToEpoch(const DateTime &dt) {
+  uint32_t days = daysFromCivil(dt.year, dt.month, dt.day);
+  return days * 86400UL + dt.hour * 3600UL + dt.minute * 60UL + dt.second;
+}
+
+void epochToDateTime(uint32_t epoch, DateTime &dt) {
+  uint32_t days = epoch / 86400UL;
+  uint32_t secs = epoch % 86400UL;
+  dt.hour = secs / 3600UL;
+  dt.minute = (secs / 60) % 60;
+  dt.second = secs % 60;
+
+  // H. Hinnant's civil_from_days
+  uint32_t z = days + 719468UL;
+  uint16_t era = z / 146097UL;
+  uint32_t doe = z - era * 146097UL;
+  uint16_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  uint16_t doy = doe - (365UL * yoe + yoe / 4 - yoe / 100);
+  uint8_t mp = (5 * doy + 2) / 153;
+  dt.day = doy - (153 * mp + 2) / 5 + 1;
+  dt.month = mp < 10 ? mp + 3 : mp - 9;
+  dt.year = yoe + era * 400 + (dt.month <= 2);
+  dt.dataValid = true;
+}
+
+int32_t timestampDiffMs(const Timestamp &from, const Timestamp &to) {
+  return (int32_t)(to.epoch - from.epoch) * 1000L + ((int16_t)to.ms - (int16_t)from.ms);
+}
+
 // Unused functions removed to save memory
 
@@ -5,22 +5,44 @@
 #include "temp.h"
 #include "gps.h"
 #include "uSD.h"
+#include "timebase.h"
+#include "pad_idle.h"
+#include "imu_icm20948.h"
+#include "launch_detect.h"
 
 // Global sequencer state
 SequencerControl sequencer;
 SequencerTelemetryData sequencerData;
+unsigned long padWakeMillis = 0;   // Last wake-on-motion while waiting for launch
+static bool landedSeen = false;
+static unsigned long landedMillis = 0;
+
+static void logTransition(const SeqMachine &m, uint8_t from, uint8_t fromPhase) {
+  Serial.print(F("State Transition: "));
+  Serial.print(getStateName((SequencerState)from));
+  Serial.print(F(" -> "));
+  Serial.println(getStateName((SequencerState)m.state));
+
+  if (m.phase != fromPhase) {
+    Serial.print(F("Phase Transition: "));
+    Serial.print(getPhaseName((MissionPhase)fromPhase));
+    Serial.print(F(" -> "));
+    Serial.println(getPhaseName((MissionPhase)m.phase));
+  }
+}
 
 void initSequencer() {
-  sequencer.currentState = SBIT_INIT_SEQ_IMU;
-  sequencer.currentPhase = PHASE_STARTUP;
-  sequencer.stateStartTime = millis();
   sequencer.lastStateUpdate = millis();
   sequencer.sequenceActive = true;
   sequencer.emergencyAbort = false;
-  sequencer.sequenceRetries = 0;
   sequencer.launchAltitude = 0.0;
   sequencer.maxAltitude = 0.0;
   sequencer.apogeeDetected = false;
+  landedSeen = false;
+
+  sequencer.machine.onTransition = logTransition;
+  seqStart(sequencer.machine, sequencerStates, SEQ_STATE_COUNT, SBIT_INIT_SEQ_IMU,
+           PHASE_STARTUP, SEQ_MAX_RETRIES, millis());
   
   Serial.println(F("Sequencer initialized - Beginning SBIT sequence"));
 }
@@ -31,207 +53,184 @@ void updateSequencer() {
   }
   
   if (sequencer.emergencyAbort) {
-    executeAbortSequence();
-    return;
-  }
-  
-  // Check for state timeout
-  if (millis() - sequencer.stateStartTime > STATE_TIMEOUT_MS) {
-    Serial.print(F("WARNING: State timeout for "));
-    Serial.println(getStateString(sequencer.currentState));
-    
-    // Handle timeout based on current state
-    if (sequencer.currentState <= SBIT_RBSAFE_CHECK) {
-      // Startup phase timeout - retry or abort
-      sequencer.sequenceRetries++;
-      if (sequencer.sequenceRetries > 3) {
-        Serial.println(F("ABORT: Too many startup failures"));
-        sequencer.emergencyAbort = true;
-        return;
-      }
+    // Once: ABIT's entry safes everything and stops the sequencer
+    if (currentSequencerState() != ABIT_KILL_ALL_PROCESSES) {
+      executeAbortSequence();
     }
+    return;
   }
   
-  // Execute current state logic
   executeCurrentState();
 }
 
+// Launch latched between ticks: run LBIT-6 now, under the same checks as
+// updateSequencer() (paused or aborting waits for the tick)
+void sequencerOnLaunch() {
+  if (!sequencer.sequenceActive || sequencer.emergencyAbort) return;
+  if (currentSequencerState() != LBIT_IGNIT_BOOSTER) return;
+  executeCurrentState();
+}
+
+// One pass of the state table: tick, guard, timeout
 void executeCurrentState() {
-  switch (sequencer.currentState) {
-    case SBIT_INIT_SEQ_IMU:
-      Serial.println(F("SBIT-0: Initializing Sequencer & IMU"));
-      // Initialize IMU when imu.cpp is implemented
-      // For now, just transition after sensor checks
-      if (checkSensorStatus()) {
-        transitionToState(SBIT_STARTUP_BATTERY);
-      }
-      break;
-      
-    case SBIT_STARTUP_BATTERY:
-      Serial.println(F("SBIT-1: Checking Startup Battery"));
-      checkBatteryStatus();
-      if (sequencerData.batteryOK) {
-        transitionToState(SBIT_STARTUP_TELEM);
-      }
-      break;
-      
-    case SBIT_STARTUP_TELEM:
-      Serial.println(F("SBIT-2: Starting Telemetry Systems"));
-      // Telemetry already running, verify all sensors
-      if (sequencerData.sensorsOK) {
-        transitionToState(SBIT_STARTUP_PAYLOAD);
-      }
-      break;
-      
-    case SBIT_STARTUP_PAYLOAD:
-      Serial.println(F("SBIT-3: Checking Payload Battery"));
-      enablePayloadPower();
-      // Add payload battery check here
-      sequencerData.payloadOK = true; // Placeholder
-      if (sequencerData.payloadOK) {
-        transitionToState(SBIT_PAYLOAD_TELEM);
-      }
-      break;
-      
-    case SBIT_PAYLOAD_TELEM:
-      Serial.println(F("SBIT-4: Starting Payload Telemetry"));
-      // Verify payload sensors are responding
-      if (sequencerData.payloadOK && sequencerData.sensorsOK) {
-        transitionToState(SBIT_RBSAFE_CHECK);
-      }
-      break;
-      
-    case SBIT_RBSAFE_CHECK:
-      Serial.println(F("SBIT-5: RBSAFE Validation Check"));
-      // Perform final safety checks
-      if (sequencerData.batteryOK && sequencerData.sensorsOK && sequencerData.payloadOK) {
-        Serial.println(F("SBIT Complete - Ready for Launch Sequence"));
-        transitionToState(LBIT_IGNIT_BOOSTER);
-        transitionToPhase(PHASE_PREFLIGHT);
-      }
-      break;
-      
-    case LBIT_IGNIT_BOOSTER:
-      Serial.println(F("LBIT-6: Booster Ignition Ready"));
-      // Wait for launch detection via accelerometer
-      if (sequencerData.accel_magnitude > LAUNCH_ACCEL_THRESHOLD_G) {
-        igniteBooster();
-        sequencer.launchAltitude = sequencerData.altitudeAGL;
-        transitionToState(LBIT_LAUNCH);
-        transitionToPhase(PHASE_LAUNCH);
-      }
+  switch (seqTick(sequencer.machine, millis())) {
+    case SEQ_RETRY:
+      Serial.print(F("WARNING: State timeout, retrying "));
+      Serial.println(getStateName(currentSequencerState()));
       break;
-      
-    case LBIT_LAUNCH:
-      Serial.println(F("LBIT-7: LAUNCH CONFIRMED!"));
-      // Monitor initial ascent
-      if (sequencerData.altitudeAGL > sequencer.launchAltitude + 50.0) {
-        transitionToState(LBIT_POST_LAUNCH_REPORT);
-        transitionToPhase(PHASE_FLIGHT);
-      }
+    case SEQ_EXHAUSTED:
+      Serial.println(F("ABORT: Too many startup failures"));
+      sequencer.emergencyAbort = true;
       break;
-      
-    case LBIT_POST_LAUNCH_REPORT:
-      Serial.println(F("LBIT-8: Post-Launch Report"));
-      sendTelemetryBurst();
-      // Track for apogee
-      if (sequencerData.altitude > sequencer.maxAltitude) {
-        sequencer.maxAltitude = sequencerData.altitude;
-      }
-      if (sequencerData.vertical_velocity < APOGEE_VELOCITY_THRESHOLD) {
-        sequencer.apogeeDetected = true;
-        transitionToState(LBIT_APOGEE_REPORT);
-      }
-      break;
-      
-    case LBIT_APOGEE_REPORT:
-      Serial.println(F("LBIT-9: Apogee Detected - Reporting"));
-      Serial.print(F("Maximum Altitude: "));
-      Serial.print(sequencer.maxAltitude);
-      Serial.println(F(" meters"));
-      sendTelemetryBurst();
-      transitionToState(DBIT_POP_NOSE_FAIRING);
-      transitionToPhase(PHASE_DEPLOY);
-      break;
-      
-    case DBIT_POP_NOSE_FAIRING:
-      Serial.println(F("DBIT-10: Popping Nose Fairing"));
-      popNoseFairing();
-      delay(2000); // Allow fairing to clear
-      transitionToState(DBIT_STAGE_SEPARATION);
-      break;
-      
-    case DBIT_STAGE_SEPARATION:
-      Serial.println(F("DBIT-11: Stage Separation"));
-      separateStage();
-      delay(3000); // Allow separation
-      transitionToState(DBIT_BOOM_PAYLOAD);
-      break;
-      
-    case DBIT_BOOM_PAYLOAD:
-      Serial.println(F("DBIT-12: Deploying Payload"));
-      deployPayload();
-      transitionToState(DBIT_FINAL_MODE);
-      break;
-      
-    case DBIT_FINAL_MODE:
-      Serial.println(F("DBIT-13: Final Deploy Mode"));
-      // Wait a bit before parachute deployment
-      if (millis() - sequencer.stateStartTime > 5000) {
-        transitionToState(DBIT_DEPLOY_PARACHUTE);
-      }
-      break;
-      
-    case DBIT_DEPLOY_PARACHUTE:
-      Serial.println(F("DBIT-14: Deploying Parachute"));
-      deployParachute();
-      transitionToState(DBIT_SEND_ALL_TELEM);
-      transitionToPhase(PHASE_RECOVERY);
-      break;
-      
-    case DBIT_SEND_ALL_TELEM:
-      Serial.println(F("DBIT-15: Sending All Recorded Telemetry"));
-      sendTelemetryBurst();
-      // Continue logging until shutdown
-      if (sequencerData.vertical_velocity < LANDING_VELOCITY_THRESHOLD && 
-          sequencerData.accel_magnitude < 1.5) {
-        // Likely landed, prepare for shutdown
-        delay(30000); // Log for 30 more seconds
-        transitionToState(ABIT_KILL_ALL_PROCESSES);
-      }
-      break;
-      
-    case ABIT_KILL_ALL_PROCESSES:
-      Serial.println(F("ABIT-16: Mission Complete - Shutting Down"));
-      // Final telemetry burst
-      sendTelemetryBurst();
-      // Safe all pyrotechnics
-      safeAllPyrotechnics();
-      
-      sequencer.sequenceActive = false;
-      Serial.println(F("=== MISSION COMPLETE ==="));
+    default:
       break;
   }
 }
 
 void transitionToState(SequencerState newState) {
-  Serial.print(F("State Transition: "));
-  Serial.print(getStateString(sequencer.currentState));
-  Serial.print(F(" -> "));
-  Serial.println(getStateString(newState));
-  
-  sequencer.currentState = newState;
-  sequencer.stateStartTime = millis();
-  sequencer.sequenceRetries = 0; // Reset retry counter on successful transition
+  seqTransition(sequencer.machine, newState, millis());
 }
 
-void transitionToPhase(MissionPhase newPhase) {
-  Serial.print(F("Phase Transition: "));
-  Serial.print(getPhaseString(sequencer.currentPhase));
-  Serial.print(F(" -> "));
-  Serial.println(getPhaseString(newPhase));
+// SBIT: startup checks, each retried on STATE_TIMEOUT_MS
+bool sbitSensorsChecked() {
+  return checkSensorStatus();
+}
+
+void sbitCheckBattery() {
+  checkBatteryStatus();
+}
+
+bool sbitBatteryOK() {
+  return sequencerData.batteryOK;
+}
+
+bool sbitSensorsOK() {
+  // Telemetry already running, verify all sensors
+  return sequencerData.sensorsOK;
+}
+
+void sbitPayloadPower() {
+  enablePayloadPower();
+  // Add payload battery check here
+  sequencerData.payloadOK = true; // Placeholder
+}
+
+bool sbitPayloadOK() {
+  return sequencerData.payloadOK;
+}
+
+bool sbitPayloadTelemOK() {
+  // Verify payload sensors are responding
+  return sequencerData.payloadOK && sequencerData.sensorsOK;
+}
+
+bool sbitAllOK() {
+  // Final safety checks
+  return sequencerData.batteryOK && sequencerData.sensorsOK && sequencerData.payloadOK;
+}
+
+// LBIT: pad wait, launch, ascent
+void lbitPadWait() {
+  Serial.println(F("SBIT Complete - Ready for Launch Sequence"));
+  startIMUFifo();  // serviceLaunchDetector() input; paused while pad idle
+  padWakeMillis = millis();
+  enterPadIdle();
+}
+
+// Sleeping and waking belong to loop(): this only re-idles after a quiet spell
+void lbitPadService() {
+  if (!isPadIdle() && !detectLaunch() && millis() - padWakeMillis > PAD_IDLE_REARM_MS) {
+    padWakeMillis = millis();
+    enterPadIdle();  // Pad handling, not a launch: back to idle
+  }
+}
+
+// Top of every loop pass: motion puts the IMU and baro back at flight rate
+// (disarmIMUWakeOnMotion() restarts the FIFO) before anything is sampled
+void servicePadWake() {
+  if (!updatePadIdle()) return;
+  Serial.println(F("LBIT-6: Motion - flight rate"));
+  padWakeMillis = millis();
+}
+
+bool lbitLaunched() {
+  // Sustained g at FIFO rate, see serviceLaunchDetector()
+  return detectLaunch();
+}
+
+void lbitLaunch() {
+  exitPadIdle();
+  igniteBooster();
+  sequencer.launchAltitude = sequencerData.altitudeAGL;
+  Serial.print(F("Launch at "));
+  Serial.print(getLaunchMicros());
+  Serial.println(F(" us"));
+}
+
+bool lbitClearOfPad() {
+  return sequencerData.altitudeAGL > sequencer.launchAltitude + 50.0;
+}
+
+void lbitTrackAscent() {
+  sendTelemetryBurst();
+  if (sequencerData.altitude > sequencer.maxAltitude) {
+    sequencer.maxAltitude = sequencerData.altitude;
+  }
+}
+
+bool lbitApogee() {
+  return sequencerData.vertical_velocity < APOGEE_VELOCITY_THRESHOLD;
+}
+
+void lbitApogeeReport() {
+  sequencer.apogeeDetected = true;
+  Serial.print(F("Maximum Altitude: "));
+  Serial.print(sequencer.maxAltitude);
+  Serial.println(F(" meters"));
+  sendTelemetryBurst();
+}
+
+// DBIT: deployment
+// Pyro calls return at once; the dwells after them are table timeouts
+void dbitPopFairing() {
+  popNoseFairing();
+}
+
+void dbitSeparateStage() {
+  separateStage();
+}
+
+void dbitDeployPayload() {
+  deployPayload();
+}
+
+void dbitDeployParachute() {
+  deployParachute();
+}
+
+void dbitRecoveryTelemetry() {
+  sendTelemetryBurst();
+  if (!landedSeen && sequencerData.vertical_velocity < LANDING_VELOCITY_THRESHOLD &&
+      sequencerData.accel_magnitude < 1.5) {
+    // Likely landed, keep logging LANDED_LOG_MS before shutdown
+    landedSeen = true;
+    landedMillis = millis();
+  }
+}
+
+bool dbitLanded() {
+  return landedSeen && millis() - landedMillis >= LANDED_LOG_MS;
+}
+
+// ABIT: terminal state, also the end of an abort
+void abitShutdown() {
+  // Final telemetry burst
+  sendTelemetryBurst();
+  // Safe all pyrotechnics
+  safeAllPyrotechnics();
   
-  sequencer.currentPhase = newPhase;
+  sequencer.sequenceActive = false;
+  Serial.println(F("=== MISSION COMPLETE ==="));
 }
 
 void checkEmergencyConditions() {
@@ -243,10 +242,10 @@ void checkEmergencyConditions() {
   }
   
   // Check for critical battery failure
-  if (!sequencerData.batteryOK && sequencer.currentPhase >= PHASE_LAUNCH) {
+  if (!sequencerData.batteryOK && currentMissionPhase() >= PHASE_LAUNCH) {
     Serial.println(F("CRITICAL BATTERY FAILURE - EMERGENCY ACTIONS"));
     // Deploy parachute immediately if in flight
-    if (sequencer.currentPhase == PHASE_FLIGHT) {
+    if (currentMissionPhase() == PHASE_FLIGHT) {
       deployParachute();
     }
   }
@@ -255,26 +254,24 @@ void checkEmergencyConditions() {
 void executeAbortSequence() {
   Serial.println(F("EXECUTING EMERGENCY ABORT SEQUENCE"));
   
-  // Safe all pyrotechnics
-  safeAllPyrotechnics();
-  
-  // Deploy recovery systems if in flight
-  if (sequencer.currentPhase >= PHASE_LAUNCH) {
-    deployParachute();
-  }
-  
   // Send emergency telemetry
   sendTelemetryBurst();
   
-  // Transition to shutdown
+  // Transition to shutdown (ABIT's entry safes all pyrotechnics)
   transitionToState(ABIT_KILL_ALL_PROCESSES);
+  
+  // Deploy recovery systems if in flight, after the safing so the
+  // pulse runs its full PYRO_PULSE_MS
+  if (currentMissionPhase() >= PHASE_LAUNCH) {
+    deployParachute();
+  }
 }
 
 void collectSequencerTelemetry() {
   // Update sequencer data
   sequencerData.timestamp = millis();
-  sequencerData.sequencerState = sequencer.currentState;
-  sequencerData.missionPhase = sequencer.currentPhase;
+  sequencerData.sequencerState = currentSequencerState();
+  sequencerData.missionPhase = currentMissionPhase();
   
   // Read temperature
   sequencerData.temperature = readTemperatureC();
@@ -301,10 +298,8 @@ void collectSequencerTelemetry() {
   sequencerData.altitude = sequencerData.gps_alt; // Use GPS altitude for now
   sequencerData.altitudeAGL = sequencerData.altitude - sequencer.launchAltitude;
   
-  // Placeholder IMU data - implement when imu.cpp is ready
-  sequencerData.accel_x = 0.0;
-  sequencerData.accel_y = 0.0; 
-  sequencerData.accel_z = 1.0; // 1G gravity baseline
+  // Newest FIFO sample seen by the launch detector
+  getLatestAccel(sequencerData.accel_x, sequencerData.accel_y, sequencerData.accel_z);
   sequencerData.gyro_x = 0.0;
   sequencerData.gyro_y = 0.0;
   sequencerData.gyro_z = 0.0;
@@ -316,73 +311,29 @@ void collectSequencerTelemetry() {
 
 void logSequencerData() {
   if (sdCardAvailable) {
-    String dataString = formatSequencerTelemetry();
-    if (!logData(dataString)) {
+    char record[TELEMETRY_RECORD_MAX];
+    Timestamp ts;
+    getTimestamp(ts);
+    if (!formatSequencerTelemetry(record, sizeof(record)) || !writeRecord(ts, "SEQ", record)) {
       Serial.println(F("ERROR: Failed to log sequencer data"));
     }
   }
 }
 
-String formatSequencerTelemetry() {
-  String dataString = "";
-  dataString += sequencerData.timestamp;
-  dataString += ",";
-  dataString += (int)sequencerData.sequencerState;
-  dataString += ",";
-  dataString += getStateString(sequencerData.sequencerState);
-  dataString += ",";
-  dataString += (int)sequencerData.missionPhase;
-  dataString += ",";
-  dataString += getPhaseString(sequencerData.missionPhase);
-  dataString += ",";
-  dataString += sequencerData.temperature;
-  dataString += ",";
-  dataString += sequencerData.pressure;
-  dataString += ",";
-  dataString += sequencerData.altitude;
-  dataString += ",";
-  dataString += sequencerData.altitudeAGL;
-  dataString += ",";
-  dataString += sequencerData.vertical_velocity;
-  dataString += ",";
-  dataString += String(sequencerData.gps_lat, 6);
-  dataString += ",";
-  dataString += String(sequencerData.gps_lon, 6);
-  dataString += ",";
-  dataString += sequencerData.gps_alt;
-  dataString += ",";
-  dataString += sequencerData.gps_satellites;
-  dataString += ",";
-  dataString += sequencerData.accel_x;
-  dataString += ",";
-  dataString += sequencerData.accel_y;
-  dataString += ",";
-  dataString += sequencerData.accel_z;
-  dataString += ",";
-  dataString += sequencerData.accel_magnitude;
-  dataString += ",";
-  dataString += sequencerData.gyro_x;
-  dataString += ",";
-  dataString += sequencerData.gyro_y;
-  dataString += ",";
-  dataString += sequencerData.gyro_z;
-  dataString += ",";
-  dataString += sequencerData.batteryOK ? "OK" : "LOW";
-  dataString += ",";
-  dataString += sequencerData.sensorsOK ? "OK" : "FAIL";
-  dataString += ",";
-  dataString += sequencerData.payloadOK ? "OK" : "FAIL";
-  
-  return dataString;
+// No String: formats straight into buf, 0 if it doesn't fit
+size_t formatSequencerTelemetry(char *buf, size_t size) {
+  return formatTelemetryRecord(buf, size, sequencerData,
+                               (const char *)getStateName(sequencerData.sequencerState),
+                               (const char *)getPhaseName(sequencerData.missionPhase));
 }
 
 void sendTelemetryBurst() {
   // Send critical telemetry data
   Serial.println(F("=== TELEMETRY BURST ==="));
   Serial.print(F("State: "));
-  Serial.println(getStateString(sequencer.currentState));
+  Serial.println(getStateName(currentSequencerState()));
   Serial.print(F("Phase: "));
-  Serial.println(getPhaseString(sequencer.currentPhase));
+  Serial.println(getPhaseName(currentMissionPhase()));
   Serial.print(F("Altitude: "));
   Serial.print(sequencerData.altitude);
   Serial.println(F(" m"));
@@ -405,7 +356,7 @@ void blinkSequencerStatus() {
   // Blink pattern based on current phase
   unsigned long blinkRate = 1000; // Default 1Hz
   
-  switch (sequencer.currentPhase) {
+  switch (currentMissionPhase()) {
     case PHASE_STARTUP:
       blinkRate = 2000; // Slow blink
       break;
@@ -434,38 +385,12 @@ void blinkSequencerStatus() {
   }
 }
 
-String getStateString(SequencerState state) {
-  switch (state) {
-    case SBIT_INIT_SEQ_IMU: return "SBIT-0: Init Seq/IMU";
-    case SBIT_STARTUP_BATTERY: return "SBIT-1: Startup Battery";
-    case SBIT_STARTUP_TELEM: return "SBIT-2: Startup Telemetry";
-    case SBIT_STARTUP_PAYLOAD: return "SBIT-3: Startup Payload";
-    case SBIT_PAYLOAD_TELEM: return "SBIT-4: Payload Telemetry";
-    case SBIT_RBSAFE_CHECK: return "SBIT-5: RBSAFE Check";
-    case LBIT_IGNIT_BOOSTER: return "LBIT-6: Ignit Booster";
-    case LBIT_LAUNCH: return "LBIT-7: Launch";
-    case LBIT_POST_LAUNCH_REPORT: return "LBIT-8: Post Launch";
-    case LBIT_APOGEE_REPORT: return "LBIT-9: Apogee Report";
-    case DBIT_POP_NOSE_FAIRING: return "DBIT-10: Pop Nose Fairing";
-    case DBIT_STAGE_SEPARATION: return "DBIT-11: Stage Separation";
-    case DBIT_BOOM_PAYLOAD: return "DBIT-12: Boom Payload";
-    case DBIT_FINAL_MODE: return "DBIT-13: Final Mode";
-    case DBIT_DEPLOY_PARACHUTE: return "DBIT-14: Deploy Parachute";
-    case DBIT_SEND_ALL_TELEM: return "DBIT-15: Send All Telemetry";
-    case ABIT_KILL_ALL_PROCESSES: return "ABIT-16: Kill All Processes";
-    default: return "UNKNOWN";
-  }
+const __FlashStringHelper *getStateName(SequencerState state) {
+  if ((uint8_t)state >= SEQ_STATE_COUNT) return F("UNKNOWN");
+  return (const __FlashStringHelper *)pgm_read_ptr(&sequencerStates[state].name);
 }
 
-String getPhaseString(MissionPhase phase) {
-  switch (phase) {
-    case PHASE_STARTUP: return "STARTUP";
-    case PHASE_PREFLIGHT: return "PREFLIGHT";
-    case PHASE_LAUNCH: return "LAUNCH";
-    case PHASE_FLIGHT: return "FLIGHT";
-    case PHASE_DEPLOY: return "DEPLOY";
-    case PHASE_RECOVERY: return "RECOVERY";
-    case PHASE_ABORT: return "ABORT";
-    default: return "UNKNOWN";
-  }
-}
\ No newline at end of file
+const __FlashStringHelper *getPhaseName(MissionPhase phase) {
+  if ((uint8_t)phase >= SEQ_PHASE_COUNT) return F("UNKNOWN");
+  return (const __FlashStringHelper *)pgm_read_ptr(&missionPhaseNames[phase]);
+}
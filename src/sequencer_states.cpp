@@ -0,0 +1,79 @@
+#include "sequencer_states.h"
+#include "config.h"
+
+// State names, printed with F()-style helpers
+static const char nameSbit0[] PROGMEM = "SBIT-0: Init Seq/IMU";
+static const char nameSbit1[] PROGMEM = "SBIT-1: Startup Battery";
+static const char nameSbit2[] PROGMEM = "SBIT-2: Startup Telemetry";
+static const char nameSbit3[] PROGMEM = "SBIT-3: Startup Payload";
+static const char nameSbit4[] PROGMEM = "SBIT-4: Payload Telemetry";
+static const char nameSbit5[] PROGMEM = "SBIT-5: RBSAFE Check";
+static const char nameLbit6[] PROGMEM = "LBIT-6: Ignit Booster";
+static const char nameLbit7[] PROGMEM = "LBIT-7: Launch";
+static const char nameLbit8[] PROGMEM = "LBIT-8: Post Launch";
+static const char nameLbit9[] PROGMEM = "LBIT-9: Apogee Report";
+static const char nameDbit10[] PROGMEM = "DBIT-10: Pop Nose Fairing";
+static const char nameDbit11[] PROGMEM = "DBIT-11: Stage Separation";
+static const char nameDbit12[] PROGMEM = "DBIT-12: Boom Payload";
+static const char nameDbit13[] PROGMEM = "DBIT-13: Final Mode";
+static const char nameDbit14[] PROGMEM = "DBIT-14: Deploy Parachute";
+static const char nameDbit15[] PROGMEM = "DBIT-15: Send All Telemetry";
+static const char nameAbit16[] PROGMEM = "ABIT-16: Kill All Processes";
+
+#define SBIT_TIMEOUT STATE_TIMEOUT_MS
+
+// name, entry, tick, exit, guard, next, phase, timeout, timeout next
+const SeqStateDef sequencerStates[SEQ_STATE_COUNT] PROGMEM = {
+  {nameSbit0, NULL, NULL, NULL, sbitSensorsChecked,
+   SBIT_STARTUP_BATTERY, PHASE_STARTUP, SBIT_TIMEOUT, SBIT_INIT_SEQ_IMU},
+  {nameSbit1, NULL, sbitCheckBattery, NULL, sbitBatteryOK,
+   SBIT_STARTUP_TELEM, SEQ_NONE, SBIT_TIMEOUT, SBIT_STARTUP_BATTERY},
+  {nameSbit2, NULL, NULL, NULL, sbitSensorsOK,
+   SBIT_STARTUP_PAYLOAD, SEQ_NONE, SBIT_TIMEOUT, SBIT_STARTUP_TELEM},
+  {nameSbit3, sbitPayloadPower, NULL, NULL, sbitPayloadOK,
+   SBIT_PAYLOAD_TELEM, SEQ_NONE, SBIT_TIMEOUT, SBIT_STARTUP_PAYLOAD},
+  {nameSbit4, NULL, NULL, NULL, sbitPayloadTelemOK,
+   SBIT_RBSAFE_CHECK, SEQ_NONE, SBIT_TIMEOUT, SBIT_PAYLOAD_TELEM},
+  {nameSbit5, NULL, NULL, NULL, sbitAllOK,
+   LBIT_IGNIT_BOOSTER, SEQ_NONE, SBIT_TIMEOUT, SBIT_RBSAFE_CHECK},
+
+  // Waits on the pad indefinitely, no timeouts once SBIT passes
+  {nameLbit6, lbitPadWait, lbitPadService, NULL, lbitLaunched,
+   LBIT_LAUNCH, PHASE_PREFLIGHT, 0, SEQ_NONE},
+  {nameLbit7, lbitLaunch, NULL, NULL, lbitClearOfPad,
+   LBIT_POST_LAUNCH_REPORT, PHASE_LAUNCH, 0, SEQ_NONE},
+  {nameLbit8, NULL, lbitTrackAscent, NULL, lbitApogee,
+   LBIT_APOGEE_REPORT, PHASE_FLIGHT, 0, SEQ_NONE},
+  {nameLbit9, lbitApogeeReport, NULL, NULL, seqAlways,
+   DBIT_POP_NOSE_FAIRING, SEQ_NONE, 0, SEQ_NONE},
+
+  // Dwells are timeouts: the pyro pulse and the sequencer tick keep running
+  {nameDbit10, dbitPopFairing, NULL, NULL, NULL,
+   SEQ_NONE, PHASE_DEPLOY, FAIRING_CLEAR_MS, DBIT_STAGE_SEPARATION},
+  {nameDbit11, dbitSeparateStage, NULL, NULL, NULL,
+   SEQ_NONE, SEQ_NONE, STAGE_SEP_CLEAR_MS, DBIT_BOOM_PAYLOAD},
+  {nameDbit12, dbitDeployPayload, NULL, NULL, seqAlways,
+   DBIT_FINAL_MODE, SEQ_NONE, 0, SEQ_NONE},
+  {nameDbit13, NULL, NULL, NULL, NULL,
+   SEQ_NONE, SEQ_NONE, FINAL_MODE_HOLD_MS, DBIT_DEPLOY_PARACHUTE},
+  {nameDbit14, dbitDeployParachute, NULL, NULL, seqAlways,
+   DBIT_SEND_ALL_TELEM, SEQ_NONE, 0, SEQ_NONE},
+  {nameDbit15, NULL, dbitRecoveryTelemetry, NULL, dbitLanded,
+   ABIT_KILL_ALL_PROCESSES, PHASE_RECOVERY, 0, SEQ_NONE},
+
+  // Terminal: entry shuts down, nothing leaves it
+  {nameAbit16, abitShutdown, NULL, NULL, NULL,
+   SEQ_NONE, SEQ_NONE, 0, SEQ_NONE},
+};
+
+static const char phaseStartup[] PROGMEM = "STARTUP";
+static const char phasePreflight[] PROGMEM = "PREFLIGHT";
+static const char phaseLaunch[] PROGMEM = "LAUNCH";
+static const char phaseFlight[] PROGMEM = "FLIGHT";
+static const char phaseDeploy[] PROGMEM = "DEPLOY";
+static const char phaseRecovery[] PROGMEM = "RECOVERY";
+static const char phaseAbort[] PROGMEM = "ABORT";
+
+const char *const missionPhaseNames[SEQ_PHASE_COUNT] PROGMEM = {
+  phaseStartup, phasePreflight, phaseLaunch, phaseFlight, phaseDeploy, phaseRecovery, phaseAbort
+};
@@ -0,0 +1,206 @@
+#include "timebase.h"
+#include "config.h"
+
+// Anchor: wall clock epoch second that started at anchorMillis. millis(),
+// not micros(): micros() wraps every ~71.6 min, so an anchor held through a
+// long pad wait would alias; millis() wraps every ~49.7 days and its 1 ms
+// step is the timestamp resolution anyway. Sub-ms timing lives in the RTC
+// tick tracking below.
+uint32_t anchorEpoch = 0;
+unsigned long anchorMillis = 0;
+bool timebaseValid = false;
+
+// Last timestamp handed out, so a re-sync never steps time backwards
+uint32_t lastEpoch = 0;
+uint16_t lastMs = 0;
+
+// RTC 1 Hz tick: the ISR only timestamps edges; updateTimebase() re-anchors
+// on each one and tracks the Nano resonator's length of an RTC second
+volatile unsigned long tickMicros = 0;
+volatile uint16_t tickCount = 0;
+uint16_t seenTickCount = 0;
+unsigned long tickAnchorMicros = 0;   // micros() at the edge that began anchorEpoch
+float tickPeriodUs = 1000000.0;       // Resonator microseconds per RTC second
+bool tickLocked = false;
+
+// Re-sync state: watch the RTC seconds until they tick over
+unsigned long lastSyncMillis = 0;
+unsigned long resyncStartMillis = 0;
+unsigned long resyncPrevMillis = 0;
+bool resyncPending = false;
+uint32_t resyncEpoch = 0;
+
+static bool readEpoch(uint32_t &epoch) {
+  DateTime dt;
+  if (!readRTC(dt)) return false;
+  epoch = dateTimeToEpoch(dt);
+  return true;
+}
+
+static void setAnchor(uint32_t epoch, unsigned long atMillis) {
+  anchorEpoch = epoch;
+  anchorMillis = atMillis;
+  lastSyncMillis = atMillis;
+  timebaseValid = true;
+}
+
+static void rtcTickISR() {
+  tickMicros = micros();
+  tickCount++;
+}
+
+bool initTimebase() {
+  // Block (at most just over a second) for the next seconds edge so the
+  // anchor is exact rather than up to 999 ms off
+  uint32_t start;
+  if (!readEpoch(start)) return false;
+
+  unsigned long t0 = millis();
+  uint32_t epoch = start;
+  while (epoch == start) {
+    if (millis() - t0 > 1100) return false;
+    if (!readEpoch(epoch)) return false;
+  }
+
+  setAnchor(epoch, millis());
+  lastEpoch = epoch;
+  lastMs = 0;
+
+  if (TIMEBASE_USE_RTC_TICK && enableRTCSecondTick()) {
+    pinMode(RTC_INT_PIN, INPUT_PULLUP);  // INT1 is open drain
+    attachInterrupt(digitalPinToInterrupt(RTC_INT_PIN), rtcTickISR, FALLING);
+  }
+  return true;
+}
+
+// Handle new RTC tick edges. Returns false if the tick isn't (or is no
+// longer) usable and the millis() anchor should be used instead.
+static bool serviceTick() {
+  uint16_t count;
+  unsigned long edge;
+  noInterrupts();
+  count = tickCount;
+  edge = tickMicros;
+  interrupts();
+
+  if (count == seenTickCount) {
+    // Lost the tick for over two seconds: fall back on the millis() anchor
+    if (tickLocked && micros() - tickAnchorMicros > 2500000UL) {
+      setAnchor(anchorEpoch, millis() - (micros() - tickAnchorMicros) / 1000);
+      tickLocked = false;
+    }
+    return tickLocked;
+  }
+
+  uint16_t edges = count - seenTickCount;
+  seenTickCount = count;
+
+  if (!tickLocked) {
+    // First edge: read the second it started (well before the next edge)
+    uint32_t epoch;
+    if (!readEpoch(epoch)) return false;
+    anchorEpoch = epoch;
+    lastSyncMillis = millis();
+    tickLocked = true;
+  } else {
+    float period = (float)(edge - tickAnchorMicros) / edges;
+    if (fabs(period - 1000000.0) < TIMEBASE_MAX_DRIFT_PPM) {
+      tickPeriodUs += (period - tickPeriodUs) / 8.0;
+    }
+    anchorEpoch += edges;
+
+    // Periodically confirm the edge count against the RTC itself
+    if (millis() - lastSyncMillis >= TIMEBASE_RESYNC_MS) {
+      uint32_t epoch;
+      if (readEpoch(epoch)) anchorEpoch = epoch;
+      lastSyncMillis = millis();
+    }
+  }
+  tickAnchorMicros = edge;
+  return true;
+}
+
+void updateTimebase() {
+  if (!timebaseValid) return;
+  if (TIMEBASE_USE_RTC_TICK && serviceTick()) return;
+
+  if (!resyncPending) {
+    if (millis() - lastSyncMillis < TIMEBASE_RESYNC_MS) return;
+    if (!readEpoch(resyncEpoch)) {
+      lastSyncMillis = millis();  // Try again next period
+      return;
+    }
+    resyncPending = true;
+    resyncStartMillis = millis();
+    resyncPrevMillis = resyncStartMillis;
+    return;
+  }
+
+  // Poll once per loop until the RTC seconds tick over
+  unsigned long now = millis();
+  uint32_t epoch;
+  if (!readEpoch(epoch) || now - resyncStartMillis > 1100) {
+    resyncPending = false;
+    lastSyncMillis = now;
+    return;
+  }
+  if (epoch == resyncEpoch) {
+    resyncPrevMillis = now;
+    return;
+  }
+
+  // The edge happened in (resyncPrevMillis, now]. Only move the anchor if
+  // our clock puts it outside that window.
+  unsigned long derivedEdge = anchorMillis + (epoch - anchorEpoch) * 1000UL;
+  if ((long)(derivedEdge - now) > 0) {
+    setAnchor(epoch, now);               // Running slow
+  } else if ((long)(derivedEdge - resyncPrevMillis) <= 0) {
+    setAnchor(epoch, resyncPrevMillis);  // Running fast
+  } else {
+    lastSyncMillis = now;                // In sync
+  }
+  resyncPending = false;
+}
+
+bool getTimestamp(Timestamp &ts) {
+  if (!timebaseValid) {
+    unsigned long now = millis();
+    ts.epoch = now / 1000;
+    ts.ms = now % 1000;
+    return false;
+  }
+
+  uint32_t epoch;
+  uint16_t ms;
+  if (tickLocked) {
+    // Scale by the measured resonator rate; can exceed a second if the
+    // next edge hasn't been serviced yet
+    unsigned long elapsedUs = micros() - tickAnchorMicros;
+    unsigned long elapsed = (unsigned long)(elapsedUs * (1000.0 / tickPeriodUs));
+    epoch = anchorEpoch + elapsed / 1000;
+    ms = elapsed % 1000;
+  } else {
+    unsigned long elapsed = millis() - anchorMillis;
+    epoch = anchorEpoch + elapsed / 1000;
+    ms = elapsed % 1000;
+  }
+
+  if (epoch < lastEpoch || (epoch == lastEpoch && ms < lastMs)) {
+    epoch = lastEpoch;  // Clock was ahead of the RTC: hold until it catches up
+    ms = lastMs;
+  }
+  lastEpoch = epoch;
+  lastMs = ms;
+
+  ts.epoch = epoch;
+  ts.ms = ms;
+  return true;
+}
+
+bool isTimebaseValid() {
+  return timebaseValid;
+}
+
+float getTimebaseDriftPpm() {
+  return tickLocked ? tickPeriodUs - 1000000.0 : 0.0;
+}
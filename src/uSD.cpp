@@ -1,6 +1,7 @@
 #include <SD.h>
 #include "config.h"
 #include "uSD.h"
+#include "error_log.h"
 
 // Global file handle
 File dataFile;
@@ -41,7 +42,7 @@ bool startLogging(const char* fileName) {
   
   // Write CSV header only if file is new (size = 0)
   if (dataFile.size() == 0) {
-    dataFile.println(F("Timestamp,Temp_C,Pressure_hPa,Altitude_m"));
+    dataFile.println(F("Epoch_s,Temp_C,Pressure_hPa,Altitude_m,AGL_m"));
     Serial.println(F("SD: New file - header added"));
   } else {
     Serial.println(F("SD: Appending to existing file"));
@@ -64,46 +65,43 @@ bool stopLogging() {
   return true;
 }
 
-bool writeData(const DateTime& dt, const BaroData& data) {
+// Epoch seconds with a 3-digit millisecond fraction
+static void writeTimestamp(const Timestamp& ts) {
+  dataFile.print(ts.epoch);
+  dataFile.print(F("."));
+  if (ts.ms < 100) dataFile.print(F("0"));
+  if (ts.ms < 10) dataFile.print(F("0"));
+  dataFile.print(ts.ms);
+}
+
+bool writeData(const Timestamp& ts, const BaroData& data) {
   if (!isLogging) {
-    Serial.println(F("SD: Not logging"));
+    recordError(ERR_SD_NOT_LOGGING);
     return false;
   }
   
   if (!dataFile) {
-    Serial.println(F("SD: File not open"));
+    recordError(ERR_SD_NOT_OPEN);
     return false;
   }
   
-  // Format: YYYY-MM-DD HH:MM:SS,Temp,Pressure,Altitude
-  dataFile.print(dt.year);
-  dataFile.print(F("-"));
-  if (dt.month < 10) dataFile.print(F("0"));
-  dataFile.print(dt.month);
-  dataFile.print(F("-"));
-  if (dt.day < 10) dataFile.print(F("0"));
-  dataFile.print(dt.day);
-  dataFile.print(F(" "));
-  if (dt.hour < 10) dataFile.print(F("0"));
-  dataFile.print(dt.hour);
-  dataFile.print(F(":"));
-  if (dt.minute < 10) dataFile.print(F("0"));
-  dataFile.print(dt.minute);
-  dataFile.print(F(":"));
-  if (dt.second < 10) dataFile.print(F("0"));
-  dataFile.print(dt.second);
+  // Format: epoch.mmm,Temp,Pressure,Altitude,AGL
+  writeTimestamp(ts);
   dataFile.print(F(","));
   dataFile.print(data.temperature, 2);
   dataFile.print(F(","));
   dataFile.print(data.pressure, 2);
   dataFile.print(F(","));
-  dataFile.println(data.altitude, 2);
+  dataFile.print(data.altitude, 2);
+  dataFile.print(F(","));
+  dataFile.println(data.altitudeAGL, 2);
   
   dataFile.flush(); // Force write to card
   
   // Check if write was successful
   if (dataFile.getWriteError()) {
-    Serial.println(F("SD: Write error detected"));
+    recordError(ERR_SD_WRITE, dataFile.getWriteError());
+    dataFile.clearWriteError();
     return false;
   }
   
@@ -111,7 +109,7 @@ bool writeData(const DateTime& dt, const BaroData& data) {
 }
 
 // Write event data to SD card
-bool writeData(const DateTime& dt, const char* event, const char* message) {
+bool writeData(const Timestamp& ts, const char* event, const char* message) {
   if (!isLogging) {
     return false;
   }
@@ -120,23 +118,8 @@ bool writeData(const DateTime& dt, const char* event, const char* message) {
     return false;
   }
   
-  // Format: YYYY-MM-DD HH:MM:SS,EVENT,Event_Message,,
-  dataFile.print(dt.year);
-  dataFile.print(F("-"));
-  if (dt.month < 10) dataFile.print(F("0"));
-  dataFile.print(dt.month);
-  dataFile.print(F("-"));
-  if (dt.day < 10) dataFile.print(F("0"));
-  dataFile.print(dt.day);
-  dataFile.print(F(" "));
-  if (dt.hour < 10) dataFile.print(F("0"));
-  dataFile.print(dt.hour);
-  dataFile.print(F(":"));
-  if (dt.minute < 10) dataFile.print(F("0"));
-  dataFile.print(dt.minute);
-  dataFile.print(F(":"));
-  if (dt.second < 10) dataFile.print(F("0"));
-  dataFile.print(dt.second);
+  // Format: epoch.mmm,EVENT,Event_Message,,
+  writeTimestamp(ts);
   dataFile.print(F(","));
   dataFile.print(event);
   dataFile.print(F(","));
@@ -148,6 +131,74 @@ bool writeData(const DateTime& dt, const char* event, const char* message) {
   return true;
 }
 
+// Write one raw IMU sample (counts; scaled by tools/decode_log.py)
+bool writeData(const Timestamp& ts, const IMURawData& imu) {
+  if (!isLogging) {
+    recordError(ERR_SD_NOT_LOGGING);
+    return false;
+  }
+  
+  if (!dataFile) {
+    recordError(ERR_SD_NOT_OPEN);
+    return false;
+  }
+  
+  // Format: epoch.mmm,IMU,FS,ax,ay,az,gx,gy,gz,mx,my,mz,T
+  writeTimestamp(ts);
+  dataFile.print(F(",IMU,"));
+  dataFile.print(imu.fullScale);
+  for (uint8_t i = 0; i < 3; i++) {
+    dataFile.print(F(","));
+    dataFile.print(imu.accel[i]);
+  }
+  for (uint8_t i = 0; i < 3; i++) {
+    dataFile.print(F(","));
+    dataFile.print(imu.gyro[i]);
+  }
+  for (uint8_t i = 0; i < 3; i++) {
+    dataFile.print(F(","));
+    dataFile.print(imu.mag[i]);
+  }
+  dataFile.print(F(","));
+  dataFile.println(imu.temperature);
+  
+  if (dataFile.getWriteError()) {
+    recordError(ERR_SD_WRITE, dataFile.getWriteError());
+    dataFile.clearWriteError();
+    return false;
+  }
+  
+  return true;
+}
+
+// Write a record formatted by the caller (e.g. formatTelemetryRecord)
+bool writeRecord(const Timestamp& ts, const char* tag, const char* fields) {
+  if (!isLogging) {
+    recordError(ERR_SD_NOT_LOGGING);
+    return false;
+  }
+  
+  if (!dataFile) {
+    recordError(ERR_SD_NOT_OPEN);
+    return false;
+  }
+  
+  // Format: epoch.mmm,TAG,fields
+  writeTimestamp(ts);
+  dataFile.print(F(","));
+  dataFile.print(tag);
+  dataFile.print(F(","));
+  dataFile.println(fields);
+  
+  if (dataFile.getWriteError()) {
+    recordError(ERR_SD_WRITE, dataFile.getWriteError());
+    dataFile.clearWriteError();
+    return false;
+  }
+  
+  return true;
+}
+
 bool deleteFile(const char* fileName) {
   if (isLogging && strcmp(currentFileName, fileName) == 0) {
     return false; // Can't delete currently open file
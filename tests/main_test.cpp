@@ -1,5 +1,5 @@
 /*
- * Test: RTC + Baro + SD (No IMU due to memory)
+ * Test: RTC + Baro + IMU + SD (slim ICM-20948 driver, -DICM_20948_SLIM)
  */
 
  #include <Arduino.h>
@@ -7,10 +7,11 @@
  #include <SPI.h>
  #include "rtc_pcf8523.h"
  #include "baro_bmp280.h"
+ #include "imu_icm20948.h"
  #include "uSD.h"
  
  bool on;
- bool r,b,s;
+ bool r,b,i,s;
  unsigned long n,t;
  
  void setup() {
@@ -32,6 +33,10 @@
    Serial.print(F("Baro:"));
    Serial.println(b?F("OK"):F("FAIL"));
    
+   i = initIMU();
+   Serial.print(F("IMU:"));
+   Serial.println(i?F("OK"):F("FAIL"));
+   
    s = initSD();
    Serial.print(F("SD:"));
    Serial.println(s?F("OK"):F("FAIL"));
@@ -79,6 +84,13 @@
        p+=snprintf(buf+p,80-p,"NaN,NaN,NaN");
      }
      
+     IMURawData id;
+     if (i&&readIMURaw(id)) {
+       p+=snprintf(buf+p,80-p,",%d,%d,%d",id.accel[0],id.accel[1],id.accel[2]);
+     } else {
+       p+=snprintf(buf+p,80-p,",NaN,NaN,NaN");
+     }
+     
      File f=SD.open("d.csv",FILE_WRITE);
      if (f) {
        f.println(buf);
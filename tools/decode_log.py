@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""Decode a flight log (LOGxx.CSV) epoch column into ISO timestamps
+
+Usage: decode_log.py LOG00.CSV [out.csv]
+
+The firmware writes "epoch.mmm" (Unix seconds, UTC from the RTC). Rows
+logged before the timebase anchored carry uptime seconds instead; those are
+left as-is and marked in the output.
+
+IMU rows hold raw ICM-20948 counts (epoch.mmm,IMU,FS,ax,ay,az,gx,gy,gz,
+mx,my,mz,T) and are scaled here to m/s^2, rad/s, uT and degC. Their mag
+columns are uncalibrated so tools/mag_calibrate.py can fit them; MAG rows
+(epoch.mmm,MAG,mx,my,mz) carry the hard/soft-iron corrected counts and are
+scaled to uT.
+"""
+
+import csv
+import math
+import sys
+from datetime import datetime, timezone
+
+EPOCH_2000 = 946684800  # Anything earlier is uptime, not RTC time
+GRAVITY = 9.80665
+
+
+def decode(value):
+    seconds = float(value)
+    if seconds < EPOCH_2000:
+        return f"uptime+{seconds:.3f}"
+    dt = datetime.fromtimestamp(seconds, tz=timezone.utc)
+    return dt.strftime("%Y-%m-%d %H:%M:%S.") + f"{dt.microsecond // 1000:03d}"
+
+
+def scale_imu(fields):
+    """Raw IMU columns (after the IMU tag) -> physical units"""
+    fs = int(fields[0])
+    accel = GRAVITY / (16384 >> (fs >> 2))  # m/s^2 per LSB
+    gyro = math.radians(1.0) / (131.0 / (1 << (fs & 3)))  # rad/s per LSB
+    counts = [int(v) for v in fields[1:]]
+    out = [f"{c * accel:.3f}" for c in counts[0:3]]
+    out += [f"{c * gyro:.4f}" for c in counts[3:6]]
+    out += [f"{c * 0.15:.2f}" for c in counts[6:9]]
+    out.append(f"{counts[9] / 333.87 + 21.0:.2f}")
+    return out
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return 1
+
+    out = open(sys.argv[2], "w", newline="") if len(sys.argv) > 2 else sys.stdout
+    with open(sys.argv[1], newline="") as f:
+        writer = csv.writer(out)
+        for row in csv.reader(f):
+            if not row:
+                continue
+            if row[0] == "Epoch_s":
+                writer.writerow(["Timestamp"] + row[1:])
+                continue
+            try:
+                row[0] = decode(row[0])
+                if len(row) == 13 and row[1] == "IMU":
+                    row[2:] = scale_imu(row[2:])
+                elif len(row) == 5 and row[1] == "MAG":
+                    row[2:] = [f"{int(v) * 0.15:.2f}" for v in row[2:]]
+            except ValueError:
+                pass  # Leave malformed rows untouched
+            writer.writerow(row)
+
+    if out is not sys.stdout:
+        out.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
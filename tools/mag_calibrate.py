@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Fit magnetometer hard/soft-iron calibration from a flight log
+
+Usage: mag_calibrate.py LOG00.CSV [LOG01.CSV ...] [-o include/mag_cal.h]
+
+Reads the raw IMU rows (epoch.mmm,IMU,FS,ax,ay,az,gx,gy,gz,mx,my,mz,T),
+fits an ellipsoid to the magnetometer counts and writes the correction
+m' = S (m - b) that maps it onto a sphere of the same mean radius. The
+firmware applies it in fixed point (S in Q12, see include/imu_mag.h).
+Rotate the assembled payload through as many orientations as possible
+while logging; a fit from a few planes is poorly conditioned.
+"""
+
+import argparse
+import csv
+import sys
+
+import numpy as np
+
+Q = 4096  # MAG_CAL_Q = 12
+MIN_SAMPLES = 50
+
+
+def load(paths):
+    seen = set()
+    for path in paths:
+        with open(path, newline="") as f:
+            for row in csv.reader(f):
+                if len(row) != 13 or row[1] != "IMU":
+                    continue
+                try:
+                    m = tuple(int(v) for v in row[9:12])
+                except ValueError:
+                    continue
+                seen.add(m)  # The mag updates slower than the log rate
+    return np.array(sorted(seen), dtype=float)
+
+
+def fit_ellipsoid(m):
+    """Return (center, S) with |S (m - center)| ~ constant"""
+    # Fit about the data mean: the constant term of the quadric vanishes
+    # when the origin lies on the ellipsoid, which large hard iron can cause
+    mean = m.mean(axis=0)
+    x, y, z = (m - mean).T
+    # A x^2 + B y^2 + C z^2 + 2D xy + 2E xz + 2F yz + 2G x + 2H y + 2I z = 1
+    design = np.column_stack([x * x, y * y, z * z, 2 * x * y, 2 * x * z, 2 * y * z,
+                              2 * x, 2 * y, 2 * z])
+    p = np.linalg.lstsq(design, np.ones(len(m)), rcond=None)[0]
+    quad = np.array([[p[0], p[3], p[4]],
+                     [p[3], p[1], p[5]],
+                     [p[4], p[5], p[2]]])
+    center = -np.linalg.solve(quad, p[6:9])
+
+    quad /= 1.0 + center @ quad @ center
+    center += mean
+    values, vectors = np.linalg.eigh(quad)
+    if np.any(values <= 0):
+        raise ValueError("fit is not an ellipsoid (not enough orientations?)")
+    # Symmetric square root maps the ellipsoid onto the unit sphere;
+    # scale back to the geometric mean radius to keep counts
+    radius = np.prod(values) ** (-1.0 / 6.0)
+    soft = radius * (vectors @ np.diag(np.sqrt(values)) @ vectors.T)
+    return center, soft
+
+
+def header(center, soft_q):
+    rows = ", ".join("{ " + ", ".join(str(v) for v in row) + " }" for row in soft_q)
+    return (
+        "// Magnetometer hard/soft-iron calibration, generated by tools/mag_calibrate.py\n"
+        "#ifndef MAG_CAL_H\n"
+        "#define MAG_CAL_H\n"
+        "\n"
+        f"#define MAG_CAL_OFFSET {{ {', '.join(str(int(round(c))) for c in center)} }}\n"
+        f"#define MAG_CAL_SOFT {{ {rows} }}\n"
+        "\n"
+        "#endif // MAG_CAL_H\n"
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("logs", nargs="+")
+    parser.add_argument("-o", "--output", help="write mag_cal.h here (default: stdout)")
+    args = parser.parse_args()
+
+    m = load(args.logs)
+    if len(m) < MIN_SAMPLES:
+        print(f"Only {len(m)} distinct magnetometer samples, need {MIN_SAMPLES}", file=sys.stderr)
+        return 1
+
+    try:
+        center, soft = fit_ellipsoid(m)
+    except (ValueError, np.linalg.LinAlgError) as e:
+        print(f"Fit failed: {e}", file=sys.stderr)
+        return 1
+
+    soft_q = np.rint(soft * Q).astype(int)
+    if np.abs(soft_q).max() >= 8 * Q:
+        print("Soft-iron matrix out of Q12 range", file=sys.stderr)
+        return 1
+
+    before = np.linalg.norm(m - m.mean(axis=0), axis=1)
+    after = np.linalg.norm((m - center) @ soft.T, axis=1)
+    print(f"{len(m)} samples, offset {np.round(center * 0.15, 1)} uT", file=sys.stderr)
+    print(f"Radius spread {before.std() / before.mean() * 100:.1f}% -> "
+          f"{after.std() / after.mean() * 100:.1f}% "
+          f"(field {after.mean() * 0.15:.1f} uT)", file=sys.stderr)
+
+    text = header(center, soft_q)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
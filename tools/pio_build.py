@@ -0,0 +1,22 @@
+"""PlatformIO extra script (platformio.ini: extra_scripts = post:tools/pio_build.py)
+
+- Links with LTO: build_flags only reach the compiler, so -flto is added
+  to the link here as well.
+- Adds the size_report target: pio run -e nano_v4 -t size_report
+"""
+
+Import("env")  # noqa: F821 (provided by PlatformIO)
+
+env.Append(LINKFLAGS=["-flto", "-fuse-linker-plugin"])  # noqa: F821
+
+size_tool = env.subst("$SIZETOOL")  # noqa: F821
+nm_tool = size_tool[:-len("size")] + "nm" if size_tool.endswith("size") else "avr-nm"
+
+env.AddCustomTarget(  # noqa: F821
+    name="size_report",
+    dependencies="$BUILD_DIR/${PROGNAME}.elf",
+    actions=['"$PYTHONEXE" "$PROJECT_DIR/tools/size_report.py" "$BUILD_DIR/${PROGNAME}.elf" '
+             f'--nm "{nm_tool}" --size "{size_tool}"'],
+    title="Size report",
+    description="Flash and SRAM per module",
+)
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Measure PCF8523 drift against the host clock and compute its aging offset
+
+Usage: rtc_calibrate.py PORT [--minutes N] [--interval S] [--apply]
+
+Polls the flight firmware with 'T' over a tethered session, fits the RTC
+timestamp against host time (keep the host NTP-synced), and computes the
+Offset register value. With --apply it is written back with 'O<n>', which
+the firmware passes to calibrateRTC() in RTC_CAL_MODE (two-hour mode).
+Longer sessions give better estimates: 1 ppm is only 3.6 ms per hour.
+"""
+
+import argparse
+import sys
+import time
+
+import serial
+
+BAUD = 115200
+PPM_PER_LSB = 4.34  # RTC_OFFSET_TWO_HOURS; 4.069 for RTC_OFFSET_ONE_MINUTE
+
+
+def poll(ser):
+    """Return (host_time, rtc_time, offset) or None"""
+    ser.reset_input_buffer()
+    sent = time.time()
+    ser.write(b"T")
+    deadline = sent + 1.0
+    while time.time() < deadline:
+        line = ser.readline().decode(errors="ignore").split()
+        if len(line) == 4 and line[0] == "TIME" and line[2] == "OFFSET":
+            received = time.time()
+            if line[1] == "NO-RTC":
+                return None
+            # Firmware stamps roughly halfway through the round trip
+            return (sent + received) / 2, float(line[1]), int(line[3])
+    return None
+
+
+def fit_slope(xs, ys):
+    n = len(xs)
+    mx = sum(xs) / n
+    my = sum(ys) / n
+    sxx = sum((x - mx) ** 2 for x in xs)
+    sxy = sum((x - mx) * (y - my) for x, y in zip(xs, ys))
+    return sxy / sxx
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port")
+    parser.add_argument("--minutes", type=float, default=120.0)
+    parser.add_argument("--interval", type=float, default=10.0)
+    parser.add_argument("--apply", action="store_true")
+    args = parser.parse_args()
+
+    ser = serial.Serial(args.port, BAUD, timeout=0.2)
+    time.sleep(2.0)  # Board resets when the port opens
+    ser.reset_input_buffer()
+
+    hosts, errors, offset = [], [], None
+    end = time.time() + args.minutes * 60
+    while time.time() < end:
+        sample = poll(ser)
+        if sample:
+            host, rtc, offset = sample
+            hosts.append(host)
+            errors.append(rtc - host)
+            print(f"{len(hosts):5d}  rtc-host {errors[-1] * 1000:+10.1f} ms")
+        time.sleep(args.interval)
+
+    if len(hosts) < 3 or hosts[-1] - hosts[0] < 60:
+        print("Not enough samples")
+        return 1
+
+    ppm = fit_slope(hosts, errors) * 1e6  # Positive: RTC runs fast
+    new_offset = offset + round(-ppm / PPM_PER_LSB)
+    new_offset = max(-64, min(63, new_offset))
+    print(f"Drift {ppm:+.2f} ppm over {(hosts[-1] - hosts[0]) / 3600:.2f} h")
+    print(f"Offset register {offset} -> {new_offset}")
+
+    if args.apply and new_offset != offset:
+        ser.write(f"O{new_offset}\n".encode())
+        time.sleep(1.5)
+        print(ser.read(ser.in_waiting).decode(errors="ignore").strip())
+    ser.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""Report flash and SRAM use per module of a firmware ELF
+
+Usage: size_report.py .pio/build/nano_v4/firmware.elf [--nm avr-nm] [--size avr-size]
+   or: pio run -e nano_v4 -t size_report
+
+Attributes every sized symbol to the source file it was defined in (from
+the DWARF line info, so build with -g; LTO keeps it). Modules are the
+src/ file names, library names and the Arduino core. Flash is code plus
+initialised data, SRAM is initialised data plus bss, both as laid out by
+the linker. Whatever the symbols don't cover (vector table, startup
+code, alignment) is listed as (unattributed) so the totals match avr-size.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+from collections import defaultdict
+
+FLASH_MAX = 30720  # ATmega328P minus the 2 KB bootloader
+SRAM_MAX = 2048
+
+TEXT_TYPES = set("TtWw")
+DATA_TYPES = set("DdGgVv")
+BSS_TYPES = set("BbSs")
+
+
+def module_of(path):
+    if not path:
+        return "(no line info)"
+    path = path.replace("\\", "/")
+    for marker in ("/libdeps/", "/libraries/", "/lib/"):
+        if marker in path:
+            rest = path.split(marker, 1)[1].split("/")
+            # .pio/libdeps/<env>/<library>/...
+            return rest[1] if marker == "/libdeps/" and len(rest) > 1 else rest[0]
+    if "framework-arduino" in path or "/cores/arduino/" in path:
+        return "arduino core"
+    if "toolchain-" in path or "avr-libc" in path or "libgcc" in path:
+        return "libc/libgcc"
+    return os.path.splitext(os.path.basename(path))[0]
+
+
+def symbols(nm, elf):
+    out = subprocess.run([nm, "--print-size", "--size-sort", "--line-numbers", elf],
+                         check=True, capture_output=True, text=True).stdout
+    for line in out.splitlines():
+        # address size type name[\tfile:line]
+        head, _, location = line.partition("\t")
+        fields = head.split(None, 3)
+        if len(fields) < 4:
+            continue
+        size, kind = int(fields[1], 16), fields[2]
+        path = re.sub(r":\d+$", "", location.strip())
+        yield size, kind, path
+
+
+def elf_totals(size_tool, elf):
+    out = subprocess.run([size_tool, "--format=berkeley", elf],
+                         check=True, capture_output=True, text=True).stdout
+    text, data, bss = (int(v) for v in out.splitlines()[1].split()[:3])
+    return text, data, bss
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf")
+    parser.add_argument("--nm", default="avr-nm")
+    parser.add_argument("--size", default="avr-size")
+    parser.add_argument("--flash-max", type=int, default=FLASH_MAX)
+    parser.add_argument("--sram-max", type=int, default=SRAM_MAX)
+    args = parser.parse_args()
+
+    try:
+        text, data, bss = elf_totals(args.size, args.elf)
+        modules = defaultdict(lambda: [0, 0])  # flash, sram
+        for size, kind, path in symbols(args.nm, args.elf):
+            entry = modules[module_of(path)]
+            if kind in TEXT_TYPES:
+                entry[0] += size
+            elif kind in DATA_TYPES:
+                entry[0] += size
+                entry[1] += size
+            elif kind in BSS_TYPES:
+                entry[1] += size
+    except (OSError, subprocess.CalledProcessError) as e:
+        print(f"Size report failed: {e}", file=sys.stderr)
+        return 1
+
+    flash_total, sram_total = text + data, data + bss
+    attributed_flash = sum(f for f, _ in modules.values())
+    attributed_sram = sum(s for _, s in modules.values())
+    modules["(unattributed)"] = [max(flash_total - attributed_flash, 0),
+                                 max(sram_total - attributed_sram, 0)]
+
+    w = max(len(name) for name in modules) + 2
+    print(f"{'module':<{w}}{'flash':>8}{'sram':>8}")
+    for name, (flash, sram) in sorted(modules.items(), key=lambda m: (-m[1][0], -m[1][1])):
+        if flash or sram:
+            print(f"{name:<{w}}{flash:>8}{sram:>8}")
+    print(f"{'total':<{w}}{flash_total:>8}{sram_total:>8}")
+    print(f"{'of':<{w}}{args.flash_max:>8}{args.sram_max:>8}  "
+          f"({flash_total * 100 // args.flash_max}% flash, {sram_total * 100 // args.sram_max}% SRAM, "
+          f"{args.sram_max - sram_total} bytes left for the stack)")
+    return 0 if flash_total <= args.flash_max and sram_total <= args.sram_max else 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())